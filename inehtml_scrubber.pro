@@ -15,4 +15,13 @@
 ########################################################################################################################
 
 TEMPLATE = subdirs
-SUBDIRS = inehtml_scrubber
+SUBDIRS = inehtml_scrubber \
+          tests/parser_check \
+          tests/engine_check \
+          tests/hashing_device_check \
+          tests/scrubber_check \
+          tests/allocation_check \
+          tests/xxh64_check \
+          tests/chunk_hash_sink_check \
+          tests/sim_hash_sink_check \
+          tests/fan_out_sink_check
@@ -0,0 +1,95 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides a sink that collects scrubbed data in a QByteArray.
+***********************************************************************************************************************/
+
+/* .. sphinx-project inehtmlscrubber */
+
+#ifndef HTML_SCRUBBER_BYTE_ARRAY_SINK_H
+#define HTML_SCRUBBER_BYTE_ARRAY_SINK_H
+
+#include <QtGlobal>
+#include <QByteArray>
+
+#include "html_scrubber_sink.h"
+
+namespace HtmlScrubber {
+    /**
+     * Sink that appends the scrubbed data to a QByteArray.  The output is identical to that generated by
+     * \ref HtmlScrubber::Scrubber.
+     */
+    class ByteArraySink:public Sink {
+        public:
+            ByteArraySink();
+
+            ~ByteArraySink() override;
+
+            /**
+             * Method called with each run of scrubbed data, in order.  If the collected data would no longer fit in a
+             * QByteArray, the sink is marked as truncated and this and every later run are discarded.
+             *
+             * \param[in] data   Pointer to the scrubbed data.
+             *
+             * \param[in] length The length of the scrubbed data, in bytes.
+             */
+            void update(const char* data, unsigned long length) override;
+
+            /**
+             * Method you can use to discard the collected data and clear the truncated flag.  The allocated buffer
+             * is kept.
+             */
+            void clear();
+
+            /**
+             * Method you can use to reserve space, avoiding reallocation as data is collected.
+             *
+             * \param[in] length The number of bytes to reserve.
+             *
+             * \return Returns true on success.  Returns false, without reserving space, if the length exceeds
+             *         \ref HtmlScrubber::Scrubber::maximumOutputSize.
+             */
+            bool reserve(unsigned long length);
+
+            /**
+             * Method you can use to determine if scrubbed data was discarded because the collected data would have
+             * exceeded \ref HtmlScrubber::Scrubber::maximumOutputSize.
+             *
+             * \return Returns true if data was discarded since the sink was constructed or last cleared.
+             */
+            bool truncated() const;
+
+            /**
+             * Method you can use to obtain the collected data.
+             *
+             * \return Returns the scrubbed data.
+             */
+            const QByteArray& data() const;
+
+        private:
+            /**
+             * The collected data.
+             */
+            QByteArray currentData;
+
+            /**
+             * Flag indicating scrubbed data was discarded.
+             */
+            bool dataTruncated;
+    };
+};
+#endif
@@ -0,0 +1,208 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides a sink that hashes scrubbed data in content-defined chunks.
+***********************************************************************************************************************/
+
+/* .. sphinx-project inehtmlscrubber */
+
+#ifndef HTML_SCRUBBER_CHUNK_HASH_SINK_H
+#define HTML_SCRUBBER_CHUNK_HASH_SINK_H
+
+#include <cstdint>
+#include <vector>
+
+#include "html_scrubber_sink.h"
+#include "html_scrubber_xxh64.h"
+
+namespace HtmlScrubber {
+    /**
+     * Sink that divides the scrubbed data into content-defined chunks and calculates an XXH64 hash of each chunk.
+     *
+     * Chunk boundaries are placed using FastCDC, described by Xia et al., "FastCDC: a Fast and Efficient
+     * Content-Defined Chunking Approach for Data Deduplication".  A Gear rolling hash is calculated over the data and
+     * a boundary is placed where selected bits of the hash are zero.  Because boundaries depend only on nearby content,
+     * an insertion or deletion changes the chunks around it while later chunks keep their hashes.  Comparing the chunk
+     * lists of two versions of a page therefore identifies the regions that changed.
+     *
+     * No boundaries are considered in the first \ref minimumLength bytes of a chunk and a boundary is forced at
+     * \ref maximumLength bytes.  Boundaries are harder to find before \ref averageLength bytes and easier after, which
+     * keeps chunk sizes close to the average.
+     *
+     * Call \ref HtmlScrubber::ChunkHashSink::finish once the document is complete to close the last chunk.  This
+     * class does not depend on Qt.
+     */
+    class ChunkHashSink:public Sink {
+        public:
+            /**
+             * Structure describing a single chunk of scrubbed data.
+             */
+            struct Chunk {
+                /**
+                 * The offset of the chunk in the scrubbed data, in bytes.
+                 */
+                unsigned long offset;
+
+                /**
+                 * The length of the chunk, in bytes.
+                 */
+                unsigned long length;
+
+                /**
+                 * The XXH64 hash of the chunk.
+                 */
+                std::uint64_t hash;
+            };
+
+            /**
+             * The default minimum chunk length, in bytes.
+             */
+            static constexpr unsigned long defaultMinimumLength = 256;
+
+            /**
+             * The default average chunk length, in bytes.
+             */
+            static constexpr unsigned long defaultAverageLength = 1024;
+
+            /**
+             * The default maximum chunk length, in bytes.
+             */
+            static constexpr unsigned long defaultMaximumLength = 8192;
+
+            /**
+             * Constructor
+             *
+             * \param[in] minimumLength The minimum chunk length, in bytes.  Must be less than the average length.
+             *
+             * \param[in] averageLength The target average chunk length, in bytes.  Must be a power of two between 64
+             *                          and 2^28.
+             *
+             * \param[in] maximumLength The maximum chunk length, in bytes.  Must be greater than the average length.
+             */
+            ChunkHashSink(
+                unsigned long minimumLength = defaultMinimumLength,
+                unsigned long averageLength = defaultAverageLength,
+                unsigned long maximumLength = defaultMaximumLength
+            );
+
+            ~ChunkHashSink() override;
+
+            /**
+             * Method called with each run of scrubbed data, in order.
+             *
+             * \param[in] data   Pointer to the scrubbed data.
+             *
+             * \param[in] length The length of the scrubbed data, in bytes.
+             */
+            void update(const char* data, unsigned long length) override;
+
+            /**
+             * Method you can use to discard the chunks before reusing the sink for another document.
+             */
+            void clear();
+
+            /**
+             * Method you can call once the document is complete.  Closes the last chunk.
+             */
+            void finish();
+
+            /**
+             * Method you can use to obtain the chunks.
+             *
+             * \return Returns the completed chunks, in order.
+             */
+            const std::vector<Chunk>& chunks() const;
+
+            /**
+             * Method you can use to obtain the minimum chunk length.
+             *
+             * \return Returns the minimum chunk length, in bytes.
+             */
+            unsigned long minimumLength() const;
+
+            /**
+             * Method you can use to obtain the target average chunk length.
+             *
+             * \return Returns the average chunk length, in bytes.
+             */
+            unsigned long averageLength() const;
+
+            /**
+             * Method you can use to obtain the maximum chunk length.
+             *
+             * \return Returns the maximum chunk length, in bytes.
+             */
+            unsigned long maximumLength() const;
+
+        private:
+            /**
+             * Method that closes the current chunk.
+             */
+            void closeChunk();
+
+            /**
+             * The minimum chunk length.
+             */
+            unsigned long currentMinimumLength;
+
+            /**
+             * The average chunk length.
+             */
+            unsigned long currentAverageLength;
+
+            /**
+             * The maximum chunk length.
+             */
+            unsigned long currentMaximumLength;
+
+            /**
+             * Mask applied to the rolling hash before the average length is reached.
+             */
+            std::uint64_t smallMask;
+
+            /**
+             * Mask applied to the rolling hash after the average length is reached.
+             */
+            std::uint64_t largeMask;
+
+            /**
+             * The rolling hash.
+             */
+            std::uint64_t fingerprint;
+
+            /**
+             * The offset of the current chunk.
+             */
+            unsigned long chunkOffset;
+
+            /**
+             * The length of the current chunk.
+             */
+            unsigned long chunkLength;
+
+            /**
+             * The hash of the current chunk.
+             */
+            Xxh64 chunkHash;
+
+            /**
+             * The completed chunks.
+             */
+            std::vector<Chunk> currentChunks;
+    };
+};
+#endif
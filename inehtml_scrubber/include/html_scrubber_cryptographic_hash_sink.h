@@ -0,0 +1,57 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides a sink that calculates a cryptographic hash of scrubbed data.
+***********************************************************************************************************************/
+
+/* .. sphinx-project inehtmlscrubber */
+
+#ifndef HTML_SCRUBBER_CRYPTOGRAPHIC_HASH_SINK_H
+#define HTML_SCRUBBER_CRYPTOGRAPHIC_HASH_SINK_H
+
+#include <QtGlobal>
+#include <QCryptographicHash>
+
+#include "html_scrubber_sink.h"
+
+namespace HtmlScrubber {
+    /**
+     * Sink that calculates a cryptographic hash of the scrubbed data.  The hash is identical to that generated by
+     * \ref HtmlScrubber::Hasher.  Use QCryptographicHash::reset before reusing the sink for another document.
+     */
+    class CryptographicHashSink:public Sink, public QCryptographicHash {
+        public:
+            /**
+             * Constructor
+             *
+             * \param[in] hashAlgorithm The hashing algorithm to be used.
+             */
+            CryptographicHashSink(Algorithm hashAlgorithm);
+
+            ~CryptographicHashSink() override;
+
+            /**
+             * Method called with each run of scrubbed data, in order.
+             *
+             * \param[in] data   Pointer to the scrubbed data.
+             *
+             * \param[in] length The length of the scrubbed data, in bytes.
+             */
+            void update(const char* data, unsigned long length) override;
+    };
+};
+#endif
@@ -0,0 +1,107 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides a fixed size value type holding a hash.
+***********************************************************************************************************************/
+
+/* .. sphinx-project inehtmlscrubber */
+
+#ifndef HTML_SCRUBBER_DIGEST_H
+#define HTML_SCRUBBER_DIGEST_H
+
+namespace HtmlScrubber {
+    /**
+     * Value type holding a hash inline, so that a hash can be returned without a heap allocation.  An empty digest
+     * is used to indicate a rejected document.  This class does not depend on Qt.
+     */
+    class Digest {
+        public:
+            /**
+             * The largest hash, in bytes, that can be held.  Large enough for every SHA-2, SHA-3, Keccak, and BLAKE2
+             * variant.
+             */
+            static constexpr unsigned long maximumLength = 64;
+
+            /**
+             * Constructor.  Creates an empty digest.
+             */
+            Digest();
+
+            /**
+             * Constructor
+             *
+             * \param[in] data   Pointer to the hash.
+             *
+             * \param[in] length The length of the hash, in bytes.  Hashes longer than \ref maximumLength are
+             *                   truncated.
+             */
+            Digest(const char* data, unsigned long length);
+
+            ~Digest();
+
+            /**
+             * Method you can use to obtain the hash.
+             *
+             * \return Returns a pointer to the hash bytes.
+             */
+            const char* data() const;
+
+            /**
+             * Method you can use to obtain the length of the hash.
+             *
+             * \return Returns the length of the hash, in bytes.
+             */
+            unsigned long length() const;
+
+            /**
+             * Method you can use to determine if the digest is empty.
+             *
+             * \return Returns true if the digest holds no hash.
+             */
+            bool isEmpty() const;
+
+            /**
+             * Comparison operator.
+             *
+             * \param[in] other The digest to compare against.
+             *
+             * \return Returns true if the digests hold the same hash.
+             */
+            bool operator==(const Digest& other) const;
+
+            /**
+             * Comparison operator.
+             *
+             * \param[in] other The digest to compare against.
+             *
+             * \return Returns true if the digests hold different hashes.
+             */
+            bool operator!=(const Digest& other) const;
+
+        private:
+            /**
+             * The length of the hash, in bytes.
+             */
+            unsigned long currentLength;
+
+            /**
+             * The hash bytes.
+             */
+            char bytes[maximumLength];
+    };
+};
+#endif
@@ -23,24 +23,29 @@
 #ifndef HTML_SCRUBBER_ENGINE_H
 #define HTML_SCRUBBER_ENGINE_H
 
-#include <QtGlobal>
-#include <QByteArray>
-#include <QString>
-#include <QCryptographicHash>
-
 #include <cstdint>
+#include <cstring>
+#include <vector>
 
 #include "html_scrubber_parser.h"
+#include "html_scrubber_static_parser.h"
+#include "html_scrubber_sink.h"
 
 namespace HtmlScrubber {
+    class StateMap;
+
     /**
      * Class that can be used to process HTML, removing tags, whitespace, and other elements that are not visible.
      *
      * You can use this class several distinct ways:
-     * - You can use the supplied functor to simply scrub an HTML payload, in place.
+     * - You can use the supplied functor to scrub an HTML payload into a \ref HtmlScrubber::Sink.
+     * - You can attach a \ref HtmlScrubber::Sink to an engine to receive the scrubbed data.
      * - You can derive from this class, overloading the update method.  You can then call the supplied functor to
      *   do comparisons or other tasks on scrubbed HTML.
      *
+     * The engine does not depend on Qt.  \ref HtmlScrubber::Scrubber and \ref HtmlScrubber::Hasher provide Qt
+     * wrappers.
+     *
      * \note
      * To generate the base class, use the command:
      *
@@ -50,8 +55,17 @@ namespace HtmlScrubber {
      *           -c Parser                         \
      *           -n HtmlScrubber                   \
      *           -o include/html_scrubber_parser.h
+     *
+     * then regenerate the statically dispatched parser using the command:
+     *
+     *     python3 tools/generate_static_parser.py include/html_scrubber_parser.h include/html_scrubber_static_parser.h
+     *
+     * The engine uses the statically dispatched \ref HtmlScrubber::StaticParser so that transition methods can be
+     * inlined into the state machine.
      */
-    class Engine:private Parser {
+    class Engine:private StaticParser<Engine> {
+        friend class StaticParser<Engine>;
+
         public:
             /**
              * Value indicating the start of a source attribute.
@@ -83,49 +97,409 @@ namespace HtmlScrubber {
              */
             static const char finishCiteAttribute = 0x1D;
 
+            /**
+             * The number of NUL padding bytes appended to the input before it is scrubbed.  The padding is scrubbed
+             * with the input so the output can be up to this many bytes longer than the input.
+             */
+            static constexpr unsigned long paddingLength = 4;
+
+            /**
+             * Enumeration of supported parser back-ends.  All back-ends generate identical output.
+             */
+            enum class Backend {
+                /**
+                 * Indicates the switch based state machine should be used.
+                 */
+                SWITCH,
+
+                /**
+                 * Indicates the compile-time transition table in \ref HtmlScrubber::ParserTable should be used.
+                 */
+                TABLE,
+
+                /**
+                 * Indicates the block parallel scrubber should be used.  Large inputs are split into chunks, one for
+                 * the calling thread and one for each worker thread available, see
+                 * \ref HtmlScrubber::Engine::setParallelThreadLimit.  The parser is simulated from every start state
+                 * over each chunk, see \ref HtmlScrubber::StateMap, and the resulting maps are composed to find the
+                 * state and capture mode at the start of every chunk, so the chunks can then be scrubbed
+                 * concurrently.  Building the maps is only fast with AVX-512 VBMI, which the library is built with
+                 * only when the vbmi configuration option is given to qmake.  Default builds, inputs shorter than two
+                 * chunks, scrubs started while every worker thread is in use, input that is not valid UTF-8, and
+                 * \ref HtmlScrubber::Engine::runs all use the transition table serially.  Even with VBMI, a byte is
+                 * applied to the maps at only about 2.5 times the rate the table consumes it, so each worker thread
+                 * adds well under one thread's worth of throughput.
+                 */
+                PARALLEL
+            };
+
+            /**
+             * Enumeration of policies for invalid or truncated UTF-8 sequences.
+             */
+            enum class Utf8Policy {
+                /**
+                 * Indicates invalid sequences should be passed through.  A lead byte consumes the number of bytes it
+                 * announces, without checking them, and any other byte is consumed on its own.  This matches the
+                 * historical behavior of the scrubber.
+                 */
+                PASS_THROUGH,
+
+                /**
+                 * Indicates each maximal invalid subpart in kept data should be replaced by a single U+FFFD
+                 * replacement character.
+                 */
+                REPLACE,
+
+                /**
+                 * Indicates input containing any invalid sequence should be rejected without generating output.
+                 */
+                REJECT
+            };
+
+            /**
+             * Enumeration of the ways the engine can access the raw input data.
+             */
+            enum class InputMode {
+                /**
+                 * Indicates the engine should scrub its own copy of the input data.  The copy is made when the engine
+                 * is constructed, then padded and modified in place, and is available through
+                 * \ref HtmlScrubber::Engine::input.
+                 */
+                COPY,
+
+                /**
+                 * Indicates the engine should scan the input data without copying or modifying it.  Replaced bytes
+                 * are substituted as the output is generated, and the padding that the copy mode appends is
+                 * simulated.  The output is identical to that generated in copy mode.  The input data must remain
+                 * valid and unchanged until scrubbing completes.
+                 */
+                READ_ONLY
+            };
+
+            /**
+             * Enumeration of the kinds of runs reported by \ref HtmlScrubber::Engine::runs.
+             */
+            enum class RunKind : std::uint8_t {
+                /**
+                 * Indicates visible text that should be kept.
+                 */
+                TEXT,
+
+                /**
+                 * Indicates the contents of a src, href, or cite attribute that should be kept.
+                 */
+                URL,
+
+                /**
+                 * Indicates CSS style data that should be kept.
+                 */
+                STYLE,
+
+                /**
+                 * Indicates data that should be discarded.
+                 */
+                IGNORED,
+
+                /**
+                 * Indicates a single kept byte that must be replaced by \ref HtmlScrubber::Engine::Run::value, either
+                 * whitespace replaced by a space or an attribute start marker.
+                 */
+                MARKER,
+
+                /**
+                 * Indicates a maximal invalid UTF-8 subpart in kept data that must be replaced by a single U+FFFD
+                 * replacement character.  Only reported under \ref HtmlScrubber::Engine::Utf8Policy::REPLACE.
+                 */
+                REPLACEMENT
+            };
+
+            /**
+             * Structure describing a run of input bytes sharing the same kind.
+             */
+            struct Run {
+                /**
+                 * The zero based offset of the first byte of the run in the input data.
+                 */
+                unsigned long offset;
+
+                /**
+                 * The length of the run, in bytes.  Marker runs always have a length of 1.
+                 */
+                unsigned long length;
+
+                /**
+                 * The kind of run.
+                 */
+                RunKind kind;
+
+                /**
+                 * The replacement value.  Only meaningful for \ref HtmlScrubber::Engine::RunKind::MARKER runs.
+                 */
+                char value;
+            };
+
             /**
              * Constructor
              *
-             * \param[in] rawData The raw data to be scrubbed.  Data will be modified, in place when scrubbed.
+             * \param[in] rawData   The raw data to be scrubbed.  In read-only mode, the data must remain valid and
+             *                      unchanged until scrubbing completes.
+             *
+             * \param[in] length    The length of the raw data, in bytes.
+             *
+             * \param[in] inputMode The way the engine accesses the raw data.
              */
-            Engine(const QByteArray& rawData);
+            Engine(const char* rawData, unsigned long length, InputMode inputMode = InputMode::READ_ONLY);
 
-            ~Engine();
+            virtual ~Engine();
 
             /**
              * Method you can call to scrub HTML.
              *
-             * \return Returns true on success, returns false on error.
+             * \return Returns true on success, returns false on error.  An error is reported if the input contains
+             *         invalid UTF-8 and the UTF-8 policy is \ref HtmlScrubber::Engine::Utf8Policy::REJECT.
+             */
+            bool scrub();
+
+            /**
+             * Functor
+             *
+             * \param[in] rawData      The raw data to be scrubbed.  The data is neither copied nor modified.
+             *
+             * \param[in] length       The length of the raw data, in bytes.
+             *
+             * \param[in] sink         The sink to receive the scrubbed data.
+             *
+             * \param[in] scrubBackend The parser back-end to be used.
+             *
+             * \param[in] scrubPolicy  The policy used for invalid UTF-8.
+             *
+             * \return Returns true on success, returns false if the input was rejected.
              */
-            void scrub();
+            static bool scrub(
+                const char*   rawData,
+                unsigned long length,
+                Sink&         sink,
+                Backend       scrubBackend = Backend::SWITCH,
+                Utf8Policy    scrubPolicy = Utf8Policy::PASS_THROUGH
+            );
 
             /**
-             * Method you can use to obtain the current raw input data instance.
+             * Functor that scrubs a buffer in place, compacting the output over the front of the input so that no
+             * output buffer is needed.  The output never overtakes the unread input.  Under
+             * \ref HtmlScrubber::Engine::Utf8Policy::REPLACE, where replacement characters expand invalid UTF-8, the
+             * invalid subparts are counted first and the input is moved up by the growth they cause.  If the buffer
+             * can not hold that growth, the input is scrubbed through a temporary buffer of exactly the worst case
+             * size and copied back when the actual output fits.
+             *
+             * \param[in,out] data         The buffer holding the raw data.  On success the buffer holds the scrubbed
+             *                             data.  The buffer is left unchanged on failure.
+             *
+             * \param[in]     length       The length of the raw data, in bytes.
+             *
+             * \param[in]     capacity     The size of the buffer, in bytes.  Must be at least \ref paddingLength
+             *                             bytes larger than the raw data.
              *
-             * \return Returns a reference to the raw input data instance.
+             * \param[out]    outputLength The length of the scrubbed data, in bytes.
+             *
+             * \param[in]     scrubBackend The parser back-end to be used.
+             *
+             * \param[in]     scrubPolicy  The policy used for invalid UTF-8.
+             *
+             * \return Returns true on success.  Returns false if the input was rejected, if the buffer is smaller than
+             *         required, or if replacement characters made the output larger than the buffer.
              */
-            const QByteArray& input() const;
+            static bool scrubInPlace(
+                char*          data,
+                unsigned long  length,
+                unsigned long  capacity,
+                unsigned long& outputLength,
+                Backend        scrubBackend = Backend::SWITCH,
+                Utf8Policy     scrubPolicy = Utf8Policy::PASS_THROUGH
+            );
+
+            /**
+             * Method you can call to begin scrubbing a document that is supplied in chunks, as it arrives.  The data
+             * supplied to the constructor is not used.  Chunks are always scanned without being copied or modified
+             * and the output is identical to that generated by \ref HtmlScrubber::Engine::scrub for the
+             * concatenated chunks.
+             */
+            void begin();
+
+            /**
+             * Method you can call to scrub the next chunk of a document.  Parser state, capture mode, and multi-byte
+             * sequences split across chunks carry over between calls.  Output from the chunk is reported or staged
+             * before this method returns so the chunk need not remain valid afterwards.
+             *
+             * \param[in] data   Pointer to the chunk.
+             *
+             * \param[in] length The length of the chunk, in bytes.
+             *
+             * \return Returns true on success.  Returns false if the document has been rejected because it contains
+             *         invalid UTF-8 and the UTF-8 policy is \ref HtmlScrubber::Engine::Utf8Policy::REJECT.  Unlike
+             *         \ref HtmlScrubber::Engine::scrub, output preceding the invalid sequence may already have been
+             *         reported.
+             */
+            bool feed(const char* data, unsigned long length);
+
+            /**
+             * Method you can call once the last chunk of a document has been supplied.
+             *
+             * \return Returns true on success.  Returns false if the document was rejected.
+             */
+            bool finish();
+
+            /**
+             * Method you can use to bind the engine to new input data so that one engine can scrub many documents.
+             * The engine's own copy, staging buffer, sink, and settings are kept.
+             *
+             * \param[in] rawData   The raw data to be scrubbed.  In read-only mode, the data must remain valid and
+             *                      unchanged until scrubbing completes.
+             *
+             * \param[in] length    The length of the raw data, in bytes.
+             *
+             * \param[in] inputMode The way the engine accesses the raw data.
+             */
+            void setInput(const char* rawData, unsigned long length, InputMode inputMode = InputMode::READ_ONLY);
+
+            /**
+             * Method you can use to attach a sink.  The sink receives the scrubbed data unless
+             * \ref HtmlScrubber::Engine::update is overloaded.  Staging is disabled for sinks that retain the data
+             * passed to them.
+             *
+             * \param[in] newSink The new sink.  A null pointer detaches the current sink and discards the output.
+             */
+            void setSink(Sink* newSink);
+
+            /**
+             * Method you can use to determine the attached sink.
+             *
+             * \return Returns a pointer to the attached sink.  A null pointer is returned if no sink is attached.
+             */
+            Sink* sink() const;
+
+            /**
+             * Method you can use to select the parser back-end.
+             *
+             * \param[in] newBackend The new parser back-end.
+             */
+            void setBackend(Backend newBackend);
+
+            /**
+             * Method you can use to determine the current parser back-end.
+             *
+             * \return Returns the current parser back-end.
+             */
+            Backend backend() const;
+
+            /**
+             * Method you can use to limit the number of worker threads used by the block parallel back-end.  The
+             * limit is shared by every engine in the process, so concurrent scrubs divide the worker threads between
+             * them rather than each starting its own.  A scrub that finds no worker thread available runs serially on
+             * the calling thread.  The default limit is one less than the number of hardware threads.
+             *
+             * \param[in] newLimit The new limit.  A value of 0 disables block parallel scrubbing.
+             */
+            static void setParallelThreadLimit(unsigned newLimit);
+
+            /**
+             * Method you can use to determine the number of worker threads the block parallel back-end may use.
+             *
+             * \return Returns the current limit.
+             */
+            static unsigned parallelThreadLimit();
+
+            /**
+             * Method you can use to select how invalid UTF-8 is handled.
+             *
+             * \param[in] newUtf8Policy The new UTF-8 policy.
+             */
+            void setUtf8Policy(Utf8Policy newUtf8Policy);
 
-        protected:
             /**
-             * Method you can use to obtain the current raw data instance.
+             * Method you can use to determine how invalid UTF-8 is handled.
              *
-             * \return Returns a reference to the raw data instance, with modifications.
+             * \return Returns the current UTF-8 policy.
              */
-            QByteArray& input();
+            Utf8Policy utf8Policy() const;
 
             /**
-             * Pure virtual method you can overload to modify how the scrubber operates on supplied raw data.
+             * Method you can use to determine how the engine accesses the raw input data.
+             *
+             * \return Returns the input mode.
+             */
+            InputMode inputMode() const;
+
+            /**
+             * Method you can call to parse the input data into runs rather than scrubbing it.  The input data is
+             * neither copied nor modified.  The padding that \ref HtmlScrubber::Engine::scrub appends is simulated,
+             * so run offsets refer to the data returned by \ref HtmlScrubber::Engine::input followed by
+             * \ref paddingLength NUL bytes.  Concatenating every run that is not
+             * \ref HtmlScrubber::Engine::RunKind::IGNORED, substituting the value for marker runs, produces the
+             * scrubbed output.
+             *
+             * Adjacent runs of the same kind are merged.
+             *
+             * \return Returns the runs covering the entire padded input.  An empty vector is returned if the input
+             *         contains invalid UTF-8 and the UTF-8 policy is \ref HtmlScrubber::Engine::Utf8Policy::REJECT.
+             */
+            std::vector<Run> runs();
+
+            /**
+             * Method you can use to obtain the current raw input data.  In copy mode this is the engine's own copy,
+             * including padding and modifications.
+             *
+             * \return Returns a pointer to the raw input data.
+             */
+            const char* input() const;
+
+            /**
+             * Method you can use to obtain the length of the current raw input data.
+             *
+             * \return Returns the length of the raw input data, in bytes.
+             */
+            unsigned long inputLength() const;
+
+            /**
+             * Method you can use to obtain an upper bound on the length of the output generated by
+             * \ref HtmlScrubber::Engine::scrub.  The output never exceeds the padded input except under
+             * \ref HtmlScrubber::Engine::Utf8Policy::REPLACE, where each invalid subpart expands to a three byte
+             * replacement character.  Under that policy the input is validated, and invalid input is decoded, to
+             * count the replacements.
+             *
+             * \return Returns the maximum output length, in bytes.
+             */
+            unsigned long maximumOutputLength() const;
+
+        protected:
+            /**
+             * Method you can overload to modify how the scrubber operates on supplied raw data.  The scrubbed data is
+             * reported in order, however short consecutive runs may be combined into a single call.  Use \ref runs if
+             * run boundaries are needed.  The default implementation passes the data to the attached sink.
              *
              * \param[in] inputPointer The pointer to the data to be extracted or processed.
              *
              * \param[in] charsToCopy  The number of characters to be copied.
              */
-            virtual void update(const char* inputPointer, unsigned long charsToCopy) = 0;
+            virtual void update(const char* inputPointer, unsigned long charsToCopy);
+
+            /**
+             * Method you can use to enable or disable staging of short runs.  With staging disabled, every pointer
+             * passed to \ref HtmlScrubber::Engine::update refers either to the input data or to constant data that
+             * remains valid for the lifetime of the program, so the pointers can be retained while the input remains
+             * valid.  Short runs are no longer combined, which increases the number of calls.  Staging is enabled by
+             * default and is set by \ref HtmlScrubber::Engine::setSink according to
+             * \ref HtmlScrubber::Sink::retainsData.
+             *
+             * Pointers passed while scrubbing a document supplied in chunks refer to the chunks and can not be
+             * retained.
+             *
+             * \param[in] enabled If true, short runs are staged.  If false, every run is reported in place.
+             */
+            void setStaging(bool enabled);
 
         private:
             /**
-             * Virtual method triggered on the following transitions:
+             * Method triggered on the following transitions:
              *
              * * IN_TEXT_SPACE -> IN_TAG_START c == '<'
              * * IN_TEXT_MULTIPLE_SPACE -> IN_TAG_START c == '<'
@@ -137,10 +511,10 @@ namespace HtmlScrubber {
              *
              * \param[in] c        The value that triggered this transition.
              */
-            void startTag(States oldState, States newState, char& c) final;
+            void startTag(States oldState, States newState, char& c);
 
             /**
-             * Virtual method triggered on the following transitions:
+             * Method triggered on the following transitions:
              *
              * * IN_TEXT_SPACE -> IN_TEXT_MULTIPLE_SPACE std::isspace(c)
              *
@@ -150,10 +524,10 @@ namespace HtmlScrubber {
              *
              * \param[in] c        The value that triggered this transition.
              */
-            void multipleWhiteSpace(States oldState, States newState, char& c) final;
+            void multipleWhiteSpace(States oldState, States newState, char& c);
 
             /**
-             * Virtual method triggered on the following transitions:
+             * Method triggered on the following transitions:
              *
              * * IN_TEXT -> IN_TEXT_SPACE std::isspace(c)
              *
@@ -163,10 +537,10 @@ namespace HtmlScrubber {
              *
              * \param[in] c        The value that triggered this transition.
              */
-            virtual void whitespace(States oldState, States newState, char& c) final;
+            void whitespace(States oldState, States newState, char& c);
 
             /**
-             * Virtual method triggered on the following transitions:
+             * Method triggered on the following transitions:
              *
              * * IN_TEXT_SPACE -> IN_TEXT c != '<' && !std::isspace(c)
              * * IN_TEXT_MULTIPLE_SPACE -> IN_TEXT c != '<' && !std::isspace(c)
@@ -207,10 +581,10 @@ namespace HtmlScrubber {
              *
              * \param[in] c        The value that triggered this transition.
              */
-            void resumeText(States oldState, States newState, char& c) final;
+            void resumeText(States oldState, States newState, char& c);
 
             /**
-             * Virtual method triggered on the following transitions:
+             * Method triggered on the following transitions:
              *
              * * IN_TAG_SEARCH -> IN_TEXT_SPACE c == '>'
              * * IN_TAG_SPACE -> IN_TEXT_SPACE c == '>'
@@ -221,10 +595,10 @@ namespace HtmlScrubber {
              *
              * \param[in] c        The value that triggered this transition.
              */
-            void endTag(States oldState, States newState, char& c) final;
+            void endTag(States oldState, States newState, char& c);
 
             /**
-             * Virtual method triggered on the following transitions:
+             * Method triggered on the following transitions:
              *
              * * IN_TAG_SPACE_SRC_EQUALS -> IN_TAG_SPACE_SRC_EQUALS_QUOTE c == '"'
              *
@@ -234,10 +608,10 @@ namespace HtmlScrubber {
              *
              * \param[in] c        The value that triggered this transition.
              */
-            void startSrcAttribute(States oldState, States newState, char& c) final;
+            void startSrcAttribute(States oldState, States newState, char& c);
 
             /**
-             * Virtual method triggered on the following transitions:
+             * Method triggered on the following transitions:
              *
              * * IN_TAG_SPACE_SRC_EQUALS_QUOTE -> IN_TAG_SEARCH c == '"'
              *
@@ -247,10 +621,10 @@ namespace HtmlScrubber {
              *
              * \param[in] c        The value that triggered this transition.
              */
-            void endSrcAttribute(States oldState, States newState, char& c) final;
+            void endSrcAttribute(States oldState, States newState, char& c);
 
             /**
-             * Virtual method triggered on the following transitions:
+             * Method triggered on the following transitions:
              *
              * * IN_TAG_SPACE_HREF_EQUALS -> IN_TAG_SPACE_HREF_EQUALS_QUOTE c == '"'
              *
@@ -260,10 +634,10 @@ namespace HtmlScrubber {
              *
              * \param[in] c        The value that triggered this transition.
              */
-            void startHrefAttribute(States oldState, States newState, char& c) final;
+            void startHrefAttribute(States oldState, States newState, char& c);
 
             /**
-             * Virtual method triggered on the following transitions:
+             * Method triggered on the following transitions:
              *
              * * IN_TAG_SPACE_HREF_EQUALS_QUOTE -> IN_TAG_SEARCH c == '"'
              *
@@ -273,10 +647,10 @@ namespace HtmlScrubber {
              *
              * \param[in] c        The value that triggered this transition.
              */
-            void endHrefAttribute(States oldState, States newState, char& c) final;
+            void endHrefAttribute(States oldState, States newState, char& c);
 
             /**
-             * Virtual method triggered on the following transitions:
+             * Method triggered on the following transitions:
              *
              * * IN_TAG_SPACE_CITE_EQUALS -> IN_TAG_SPACE_CITE_EQUALS_QUOTE c == '"'
              *
@@ -286,10 +660,10 @@ namespace HtmlScrubber {
              *
              * \param[in] c        The value that triggered this transition.
              */
-            void startCiteAttribute(States oldState, States newState, char& c) final;
+            void startCiteAttribute(States oldState, States newState, char& c);
 
             /**
-             * Virtual method triggered on the following transitions:
+             * Method triggered on the following transitions:
              *
              * * IN_TAG_SPACE_CITE_EQUALS_QUOTE -> IN_TAG_SEARCH c == '"'
              *
@@ -299,10 +673,10 @@ namespace HtmlScrubber {
              *
              * \param[in] c        The value that triggered this transition.
              */
-            void endCiteAttribute(States oldState, States newState, char& c) final;
+            void endCiteAttribute(States oldState, States newState, char& c);
 
             /**
-             * Virtual method triggered on the following transitions:
+             * Method triggered on the following transitions:
              *
              * * IN_TAG_SCRIPT_SPACE_SRC_EQUALS -> IN_TAG_SCRIPT_SPACE_SRC_EQUALS_QUOTE c == '"'
              *
@@ -312,10 +686,10 @@ namespace HtmlScrubber {
              *
              * \param[in] c        The value that triggered this transition.
              */
-            void startScriptSrcAttribute(States oldState, States newState, char& c) final;
+            void startScriptSrcAttribute(States oldState, States newState, char& c);
 
             /**
-             * Virtual method triggered on the following transitions:
+             * Method triggered on the following transitions:
              *
              * * IN_TAG_SCRIPT_SPACE_SRC_EQUALS_QUOTE -> IN_TEXT_SPACE c == '"'
              *
@@ -325,10 +699,10 @@ namespace HtmlScrubber {
              *
              * \param[in] c        The value that triggered this transition.
              */
-            void endScriptSrcAttribute(States oldState, States newState, char& c) final;
+            void endScriptSrcAttribute(States oldState, States newState, char& c);
 
             /**
-             * Virtual method triggered on the following transitions:
+             * Method triggered on the following transitions:
              *
              * * IN_TAG_STYLE -> IN_STYLE_START c == '>'
              * * IN_STYLE_START -> IN_STYLE
@@ -339,10 +713,10 @@ namespace HtmlScrubber {
              *
              * \param[in] c        The value that triggered this transition.
              */
-            void startStyle(States oldState, States newState, char& c) final;
+            void startStyle(States oldState, States newState, char& c);
 
             /**
-             * Virtual method triggered on the following transitions:
+             * Method triggered on the following transitions:
              *
              * * IN_STYLE -> IN_TAG_START c == '<'
              *
@@ -352,9 +726,192 @@ namespace HtmlScrubber {
              *
              * \param[in] c        The value that triggered this transition.
              */
-            void endStyle(States oldState, States newState, char& c) final;
+            void endStyle(States oldState, States newState, char& c);
 
         private:
+            /**
+             * Method that scrubs the input data using a specific parser back-end.
+             *
+             * \param[in] scrubBackend The parser back-end to be used.
+             *
+             * \return Returns true on success, returns false if the input was rejected.
+             */
+            template<Backend scrubBackend> bool scrubUsing();
+
+            /**
+             * Method that parses the input data into runs using a specific parser back-end.
+             *
+             * \param[in] scrubBackend The parser back-end to be used.
+             *
+             * \param[in] result       The vector to receive the runs.
+             *
+             * \return Returns true on success, returns false if the input was rejected.
+             */
+            template<Backend scrubBackend> bool runsUsing(std::vector<Run>& result);
+
+            /**
+             * Method that copies the raw data into the engine's own copy.
+             */
+            void copyInput();
+
+            /**
+             * Method that appends the padding to the engine's own copy of the input data, making the copy first if
+             * the input is read-only.
+             *
+             * \return Returns a pointer to the padded copy.
+             */
+            char* padInput();
+
+            /**
+             * Method that scrubs valid UTF-8 input using the block parallel back-end.  Worker threads are reserved
+             * from the limit shared by all engines and the input is split into one chunk per worker thread plus one
+             * for the calling thread.  A state map is built for every chunk but the last, each on its own thread.
+             * The maps are composed to find the state and capture mode at the start of every chunk, and the chunks
+             * are then scrubbed concurrently.  The first chunk is scrubbed directly to the attached sink; the output
+             * of later chunks is recorded and passed on in order once every chunk is done.  A chunk whose thread can
+             * not be started is processed on the calling thread instead.
+             *
+             * \param[in] basePointer     Pointer to the input data.
+             *
+             * \param[in] writablePointer Pointer to the input data if it can be modified in place.  A null pointer
+             *                            indicates the input is read-only.
+             *
+             * \param[in] inputLength     The length of the input data, in bytes.
+             *
+             * \return Returns true if the input was scrubbed.  Returns false, without generating output, if the input
+             *         should be scrubbed serially, either because it is short, no worker thread is available, or the
+             *         state maps can not be built quickly on this build.
+             */
+            bool scrubChunks(const char* basePointer, char* writablePointer, unsigned long inputLength);
+
+            /**
+             * Method that reports the data pending at the end of the input, scrubs the padding when it is
+             * simulated, and flushes the staged output.
+             *
+             * \param[in] basePointer     Pointer to the input data.
+             *
+             * \param[in] inputBase       The offset of the pending output in the input data.
+             *
+             * \param[in] outputLength    The length of the pending output, including any simulated padding bytes.
+             *
+             * \param[in] overflow        The number of simulated padding bytes already consumed by the input data.
+             *
+             * \param[in] simulatePadding If true, the padding is simulated rather than present in the input data.
+             */
+            void finishOutput(
+                const char*   basePointer,
+                unsigned long inputBase,
+                unsigned long outputLength,
+                unsigned long overflow,
+                bool          simulatePadding
+            );
+
+            /**
+             * Method that returns the state map used by the block parallel back-end.  The capture settings tracked
+             * by the map mirror the capture modes set by this class' transition methods.
+             *
+             * \return Returns a reference to the shared state map.
+             */
+            static const StateMap& stateMap();
+
+            /**
+             * Method that appends a run, merging it with the previous run when possible.
+             *
+             * \param[in] result The vector to receive the run.
+             *
+             * \param[in] offset The offset of the run.
+             *
+             * \param[in] length The length of the run.
+             *
+             * \param[in] kind   The kind of run.
+             *
+             * \param[in] value  The replacement value for marker runs.
+             */
+            static inline void appendRun(
+                std::vector<Run>& result,
+                unsigned long     offset,
+                unsigned long     length,
+                RunKind           kind,
+                char              value = '\0'
+            );
+
+            /**
+             * Method that passes scrubbed data to \ref update, combining short runs.  Runs are copied into a staging
+             * buffer that is passed on when full, so that text cut into many small runs by collapsed whitespace or
+             * tags is reported in a few large calls.  A run that does not fit is split so that the buffer is always
+             * passed on completely full.  A run of at least \ref directLength bytes that starts with the buffer empty
+             * is passed on directly, up to the last multiple of \ref hashBlockSize bytes, and only its tail is
+             * staged.  Every call but the last therefore leaves the data passed on so far a whole number of hash
+             * blocks, so the MD5, SHA-1, and SHA-2 hashes never buffer a partial block between calls.  When staging
+             * is disabled every non-empty run is passed on directly.
+             *
+             * \param[in] data   Pointer to the scrubbed data.
+             *
+             * \param[in] length The length of the scrubbed data, in bytes.
+             */
+            inline void writeOutput(const char* data, unsigned long length) {
+                if (!stagingEnabled) {
+                    if (length > 0) {
+                        update(data, length);
+                    }
+                } else {
+                    unsigned long available = stagingSize - stagingLength;
+
+                    if (stagingLength > 0 && length >= available) {
+                        std::memcpy(stagingBuffer + stagingLength, data, available);
+                        update(stagingBuffer, stagingSize);
+
+                        data          += available;
+                        length        -= available;
+                        stagingLength  = 0;
+                    }
+
+                    if (stagingLength == 0 && length >= directLength) {
+                        unsigned long alignedLength = length - length % hashBlockSize;
+                        update(data, alignedLength);
+
+                        data   += alignedLength;
+                        length -= alignedLength;
+                    }
+
+                    std::memcpy(stagingBuffer + stagingLength, data, length);
+                    stagingLength += length;
+                }
+            }
+
+            /**
+             * Method that passes any staged scrubbed data to \ref update.
+             */
+            inline void flushOutput() {
+                if (stagingLength > 0) {
+                    update(stagingBuffer, stagingLength);
+                    stagingLength = 0;
+                }
+            }
+
+            /**
+             * The size of the staging buffer used to combine short runs, in bytes.  Must be a multiple of
+             * \ref hashBlockSize.
+             */
+            static constexpr unsigned long stagingSize = 4096;
+
+            /**
+             * The length, in bytes, at and above which runs starting with an empty staging buffer bypass it.
+             */
+            static constexpr unsigned long directLength = 256;
+
+            /**
+             * The largest hash block size, in bytes, used by SHA-384 and SHA-512.  Data passed on directly is cut to a
+             * multiple of this size.
+             */
+            static constexpr unsigned long hashBlockSize = 128;
+
+            /**
+             * The minimum number of bytes in each chunk scrubbed by the block parallel back-end.  Starting a thread
+             * costs far more than scrubbing a short input.
+             */
+            static constexpr unsigned long parallelChunkLength = 256 * 1024;
+
             /**
              * The supported data capture modes.
              */
@@ -385,15 +942,207 @@ namespace HtmlScrubber {
                 IN_URL
             };
 
+            /**
+             * Method that maps a capture mode to the kind of run it produces.
+             *
+             * \param[in] mode The capture mode to be mapped.
+             *
+             * \return Returns the associated run kind.
+             */
+            static inline RunKind runKind(CaptureMode mode);
+
+            /**
+             * Method that scrubs part of valid UTF-8 input using the transition table, starting from a known state
+             * and capture mode.  Output still pending at the end of the range is passed to \ref writeOutput.
+             *
+             * \param[in] basePointer     Pointer to the input data.
+             *
+             * \param[in] writablePointer Pointer to the input data if it can be modified in place.  A null pointer
+             *                            indicates the input is read-only.
+             *
+             * \param[in] rangeStart      The offset of the first byte to be scrubbed.  Must not fall inside a
+             *                            multi-byte sequence.
+             *
+             * \param[in] rangeEnd        The offset just past the last byte to be scrubbed.
+             *
+             * \param[in] entryState      The parser state at the start of the range.
+             *
+             * \param[in] entryCapture    The capture mode at the start of the range.
+             */
+            void scrubRange(
+                const char*   basePointer,
+                char*         writablePointer,
+                unsigned long rangeStart,
+                unsigned long rangeEnd,
+                States        entryState,
+                CaptureMode   entryCapture
+            );
+
+            /**
+             * Method that scrubs the ASCII byte at the current position and then skips any keyword or run of bytes
+             * following it that can not change the state.  This is the per-byte step shared by the scrubbing loops.
+             * Defined in the internal header html_scrubber_engine_step.h.
+             *
+             * \param[in]     scrubBackend    The parser back-end to be used.
+             *
+             * \param[in]     basePointer     Pointer to the input data.
+             *
+             * \param[in]     writablePointer Pointer to the input data if it can be modified in place.  A null
+             *                                pointer indicates the input is read-only.
+             *
+             * \param[in]     endIndex        The offset just past the last byte that may be consumed.
+             *
+             * \param[in,out] inputBase       The offset of the pending output.
+             *
+             * \param[in,out] inputIndex      The offset of the byte to be scrubbed.  Updated to the next byte to be
+             *                                scrubbed.
+             *
+             * \param[in,out] outputLength    The length of the pending output.
+             */
+            template<Backend scrubBackend> inline void scrubStep(
+                const char*    basePointer,
+                char*          writablePointer,
+                unsigned long  endIndex,
+                unsigned long& inputBase,
+                unsigned long& inputIndex,
+                unsigned long& outputLength
+            );
+
+            /**
+             * Method that completes \ref scrubStep once the parser has consumed the byte.  Used directly by callers
+             * that look transitions up themselves.
+             *
+             * \param[in]     basePointer     Pointer to the input data.
+             *
+             * \param[in]     writablePointer Pointer to the input data if it can be modified in place.  A null
+             *                                pointer indicates the input is read-only.
+             *
+             * \param[in]     c               The byte value after any change made by the transition methods.
+             *
+             * \param[in]     lastCaptureMode The capture mode before the byte was parsed.
+             *
+             * \param[in]     endIndex        The offset just past the last byte that may be consumed.
+             *
+             * \param[in,out] inputBase       The offset of the pending output.
+             *
+             * \param[in,out] inputIndex      The offset of the parsed byte.  Updated to the next byte to be
+             *                                scrubbed.
+             *
+             * \param[in,out] outputLength    The length of the pending output.
+             */
+            inline void captureStep(
+                const char*    basePointer,
+                char*          writablePointer,
+                char           c,
+                CaptureMode    lastCaptureMode,
+                unsigned long  endIndex,
+                unsigned long& inputBase,
+                unsigned long& inputIndex,
+                unsigned long& outputLength
+            );
+
+            /**
+             * Method that skips a keyword the parser can jump over followed by a run of bytes that can not change
+             * the state.  The state is updated past any matched keyword.
+             *
+             * \param[in] data   Pointer to the data following the last parsed byte.
+             *
+             * \param[in] length The number of bytes available.
+             *
+             * \return Returns the number of bytes skipped.
+             */
+            inline unsigned long advance(const char* data, unsigned long length);
+
+            /**
+             * Method that returns a pointer to constant data holding a byte value.  Used to report bytes changed by
+             * the transition methods when the input is read-only.
+             *
+             * \param[in] c The byte value.
+             *
+             * \return Returns a pointer to a byte holding the value.
+             */
+            static const char* byteValue(char c);
+
             /**
              * The current data capture mode.
              */
             CaptureMode captureMode;
 
             /**
-             * The raw data to be scrubbed.
+             * The selected parser back-end.
+             */
+            Backend currentBackend;
+
+            /**
+             * The selected UTF-8 policy.
+             */
+            Utf8Policy currentUtf8Policy;
+
+            /**
+             * The input mode.
+             */
+            InputMode currentInputMode;
+
+            /**
+             * Flag indicating the document being streamed has not been rejected.
+             */
+            bool streamValid;
+
+            /**
+             * The number of bytes of the next chunk consumed by a multi-byte sequence started in an earlier chunk.
+             * Used under \ref HtmlScrubber::Engine::Utf8Policy::PASS_THROUGH.
+             */
+            unsigned long pendingSkip;
+
+            /**
+             * The number of bytes held in the pending sequence.
+             */
+            unsigned long pendingSequenceLength;
+
+            /**
+             * The leading bytes of a multi-byte sequence split across chunks.
+             */
+            char pendingSequence[4];
+
+            /**
+             * Flag indicating short runs are combined in the staging buffer.
+             */
+            bool stagingEnabled;
+
+            /**
+             * The number of bytes held in the staging buffer.
+             */
+            unsigned long stagingLength;
+
+            /**
+             * Buffer used to combine short runs of scrubbed data.
+             */
+            char stagingBuffer[stagingSize];
+
+            /**
+             * The attached sink.
+             */
+            Sink* currentSink;
+
+            /**
+             * Pointer to the raw data supplied to the engine.
+             */
+            const char* inputData;
+
+            /**
+             * The length of the raw data supplied to the engine, in bytes.
+             */
+            unsigned long inputDataLength;
+
+            /**
+             * Flag indicating the engine scrubs its own copy of the raw data.
+             */
+            bool inputCopied;
+
+            /**
+             * The engine's own copy of the raw data.
              */
-            QByteArray inputData;
+            std::vector<char> inputBuffer;
     };
 };
 #endif
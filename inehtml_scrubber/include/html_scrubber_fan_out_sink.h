@@ -0,0 +1,94 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides a sink that passes scrubbed data to several other sinks.
+***********************************************************************************************************************/
+
+/* .. sphinx-project inehtmlscrubber */
+
+#ifndef HTML_SCRUBBER_FAN_OUT_SINK_H
+#define HTML_SCRUBBER_FAN_OUT_SINK_H
+
+#include <vector>
+
+#include "html_scrubber_sink.h"
+
+namespace HtmlScrubber {
+    /**
+     * Sink that passes each run of scrubbed data to any number of registered sinks, in the order they were added.
+     * Attaching this sink to an \ref HtmlScrubber::Engine produces the scrubbed output, several hashes, and any other
+     * results from a single parse of the document.
+     *
+     * The engine decides whether to stage short runs when the sink is attached, so register every sink before
+     * attaching this sink to an engine.  This class does not depend on Qt.
+     */
+    class FanOutSink:public Sink {
+        public:
+            FanOutSink();
+
+            ~FanOutSink() override;
+
+            /**
+             * Method you can use to register a sink.  Sinks are not owned by this class.
+             *
+             * \param[in] sink Pointer to the sink to receive the scrubbed data.
+             */
+            void addSink(Sink* sink);
+
+            /**
+             * Method you can use to remove a registered sink.
+             *
+             * \param[in] sink Pointer to the sink to be removed.
+             */
+            void removeSink(Sink* sink);
+
+            /**
+             * Method you can use to remove every registered sink.
+             */
+            void clearSinks();
+
+            /**
+             * Method you can use to obtain the registered sinks.
+             *
+             * \return Returns the registered sinks, in order.
+             */
+            const std::vector<Sink*>& sinks() const;
+
+            /**
+             * Method that indicates if any registered sink retains the pointers passed to it.
+             *
+             * \return Returns true if any registered sink retains data.
+             */
+            bool retainsData() const override;
+
+            /**
+             * Method called with each run of scrubbed data, in order.
+             *
+             * \param[in] data   Pointer to the scrubbed data.
+             *
+             * \param[in] length The length of the scrubbed data, in bytes.
+             */
+            void update(const char* data, unsigned long length) override;
+
+        private:
+            /**
+             * The registered sinks.
+             */
+            std::vector<Sink*> currentSinks;
+    };
+};
+#endif
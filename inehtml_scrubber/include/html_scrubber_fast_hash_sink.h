@@ -0,0 +1,77 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides a sink that calculates an XXH64 hash of scrubbed data.
+***********************************************************************************************************************/
+
+/* .. sphinx-project inehtmlscrubber */
+
+#ifndef HTML_SCRUBBER_FAST_HASH_SINK_H
+#define HTML_SCRUBBER_FAST_HASH_SINK_H
+
+#include <cstdint>
+
+#include "html_scrubber_sink.h"
+#include "html_scrubber_xxh64.h"
+
+namespace HtmlScrubber {
+    /**
+     * Sink that calculates an XXH64 hash of the scrubbed data.  The hash is identical to that generated by
+     * \ref HtmlScrubber::FastHasher with the same seed.  This class does not depend on Qt.
+     */
+    class FastHashSink:public Sink {
+        public:
+            /**
+             * Constructor
+             *
+             * \param[in] seed The seed for the hash.
+             */
+            FastHashSink(std::uint64_t seed = 0);
+
+            ~FastHashSink() override;
+
+            /**
+             * Method called with each run of scrubbed data, in order.
+             *
+             * \param[in] data   Pointer to the scrubbed data.
+             *
+             * \param[in] length The length of the scrubbed data, in bytes.
+             */
+            void update(const char* data, unsigned long length) override;
+
+            /**
+             * Method you can use to restart the hash before reusing the sink for another document.
+             *
+             * \param[in] seed The seed for the hash.
+             */
+            void reset(std::uint64_t seed = 0);
+
+            /**
+             * Method you can use to obtain the hash.
+             *
+             * \return Returns the hash of the data received so far.
+             */
+            std::uint64_t result() const;
+
+        private:
+            /**
+             * The hash state.
+             */
+            Xxh64 hashState;
+    };
+};
+#endif
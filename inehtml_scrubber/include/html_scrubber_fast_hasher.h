@@ -0,0 +1,238 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides a class that generates fast, non-cryptographic hashes from scrubbed HTML.
+***********************************************************************************************************************/
+
+/* .. sphinx-project inehtmlscrubber */
+
+#ifndef HTML_SCRUBBER_FAST_HASHER_H
+#define HTML_SCRUBBER_FAST_HASHER_H
+
+#include <QtGlobal>
+#include <QByteArray>
+#include <QString>
+
+#include <cstdint>
+
+#include "html_scrubber_engine.h"
+#include "html_scrubber_xxh64.h"
+
+namespace HtmlScrubber {
+    /**
+     * Class that generates 64-bit XXH64 hashes from scrubbed HTML.  Use this class in place of
+     * \ref HtmlScrubber::Hasher to detect changes between fetches of a page, where a cryptographic hash is not needed.
+     * The hash is calculated at close to memory bandwidth and is returned as an integer, so it can be stored in
+     * compact tables without allocating.
+     *
+     * The hash is identical to the XXH64 hash of the output of \ref HtmlScrubber::Scrubber for the same input.
+     */
+    class FastHasher:private Engine {
+        public:
+            using Engine::Backend;
+            using Engine::setBackend;
+            using Engine::backend;
+            using Engine::setParallelThreadLimit;
+            using Engine::parallelThreadLimit;
+            using Engine::Utf8Policy;
+            using Engine::setUtf8Policy;
+            using Engine::utf8Policy;
+            using Engine::InputMode;
+            using Engine::inputMode;
+            using Engine::feed;
+
+            /**
+             * Constructor.  Use this constructor when the document will be supplied in chunks through
+             * \ref HtmlScrubber::FastHasher::begin, \ref HtmlScrubber::Engine::feed, and
+             * \ref HtmlScrubber::FastHasher::finish.
+             */
+            FastHasher();
+
+            /**
+             * Constructor
+             *
+             * \param[in] rawData   The raw data to be scrubbed and hashed.
+             *
+             * \param[in] inputMode The way the hasher accesses the raw data.
+             */
+            FastHasher(const QByteArray& rawData, InputMode inputMode = InputMode::COPY);
+
+            /**
+             * Constructor.  The hasher scans the supplied data without copying or modifying it.
+             *
+             * \param[in] rawData The raw data to be scrubbed and hashed.  The data must remain valid and unchanged
+             *                    until scrubbing completes.
+             *
+             * \param[in] length  The length of the raw data, in bytes.
+             */
+            FastHasher(const char* rawData, unsigned long length);
+
+            ~FastHasher() override;
+
+            /**
+             * Method you can use to select the hash seed.  Takes effect when the next document is started.
+             *
+             * \param[in] newSeed The new seed.  The default seed is 0.
+             */
+            void setSeed(std::uint64_t newSeed);
+
+            /**
+             * Method you can use to determine the hash seed.
+             *
+             * \return Returns the current seed.
+             */
+            std::uint64_t seed() const;
+
+            /**
+             * Method you can use to bind the hasher to a new document.
+             *
+             * \param[in] rawData   The raw data to be scrubbed and hashed.
+             *
+             * \param[in] inputMode The way the hasher accesses the raw data.
+             */
+            void setInput(const QByteArray& rawData, InputMode inputMode = InputMode::COPY);
+
+            /**
+             * Method you can use to bind the hasher to a new document that is scanned without being copied or
+             * modified.
+             *
+             * \param[in] rawData The raw data to be scrubbed and hashed.  The data must remain valid and unchanged
+             *                    until scrubbing completes.
+             *
+             * \param[in] length  The length of the raw data, in bytes.
+             */
+            void setInput(const char* rawData, unsigned long length);
+
+            /**
+             * Method you can call to scrub HTML.
+             *
+             * \return Returns true on success, returns false on error.  An error is reported if the input contains
+             *         invalid UTF-8 and the UTF-8 policy is \ref HtmlScrubber::Engine::Utf8Policy::REJECT.
+             */
+            bool scrubAndHash();
+
+            /**
+             * Method you can call to begin scrubbing and hashing a document that is supplied in chunks.
+             */
+            void begin();
+
+            /**
+             * Method you can call once the last chunk of a document has been supplied.
+             *
+             * \return Returns true on success.  Returns false if the document was rejected.
+             */
+            bool finish();
+
+            /**
+             * Method you can use to obtain the hash.
+             *
+             * \return Returns the hash of the data scrubbed so far.
+             */
+            std::uint64_t result() const;
+
+            /**
+             * Functor
+             *
+             * \param[in]  rawData      The raw data to be scrubbed.  The data is not copied or modified.
+             *
+             * \param[in]  length       The length of the raw data, in bytes.
+             *
+             * \param[out] hash         The resulting hash.  The value is unchanged if the input was rejected.
+             *
+             * \param[in]  scrubBackend The parser back-end to be used.
+             *
+             * \param[in]  scrubPolicy  The policy used for invalid UTF-8.
+             *
+             * \return Returns true on success.  Returns false if the input was rejected.
+             */
+            static bool scrubAndHash(
+                const char*    rawData,
+                unsigned long  length,
+                std::uint64_t& hash,
+                Backend        scrubBackend = Backend::SWITCH,
+                Utf8Policy     scrubPolicy = Utf8Policy::PASS_THROUGH
+            );
+
+            /**
+             * Functor
+             *
+             * \param[in]  rawData      The raw data instance to be scrubbed.
+             *
+             * \param[out] hash         The resulting hash.  The value is unchanged if the input was rejected.
+             *
+             * \param[in]  scrubBackend The parser back-end to be used.
+             *
+             * \param[in]  scrubPolicy  The policy used for invalid UTF-8.
+             *
+             * \return Returns true on success.  Returns false if the input was rejected.
+             */
+            static bool scrubAndHash(
+                const QByteArray& rawData,
+                std::uint64_t&    hash,
+                Backend           scrubBackend = Backend::SWITCH,
+                Utf8Policy        scrubPolicy = Utf8Policy::PASS_THROUGH
+            );
+
+            /**
+             * Functor that scrubs and hashes a memory mapped file.
+             *
+             * \param[in]  filename     The name of the file to be scrubbed.
+             *
+             * \param[out] hash         The resulting hash.  The value is unchanged on error.
+             *
+             * \param[in]  scrubBackend The parser back-end to be used.
+             *
+             * \param[in]  scrubPolicy  The policy used for invalid UTF-8.
+             *
+             * \return Returns true on success.  Returns false if the file could not be mapped or the input was
+             *         rejected.
+             */
+            static bool scrubAndHashFile(
+                const QString& filename,
+                std::uint64_t& hash,
+                Backend        scrubBackend = Backend::SWITCH,
+                Utf8Policy     scrubPolicy = Utf8Policy::PASS_THROUGH
+            );
+
+        protected:
+            /**
+             * Method you can overload to modify how the scrubber operates on supplied raw data.
+             *
+             * \param[in] inputPointer The pointer to the data to be extracted or processed.
+             *
+             * \param[in] charsToCopy  The number of characters to be copied.
+             */
+            void update(const char* inputPointer, unsigned long charsToCopy) override;
+
+        private:
+            /**
+             * The hash state.
+             */
+            Xxh64 hashState;
+
+            /**
+             * The hash seed.
+             */
+            std::uint64_t currentSeed;
+
+            /**
+             * The raw data to be scrubbed.  Holding a reference keeps read-only data valid while it is scanned.
+             */
+            QByteArray inputData;
+    };
+};
+#endif
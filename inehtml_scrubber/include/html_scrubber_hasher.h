@@ -27,33 +27,181 @@
 #include <QByteArray>
 #include <QString>
 #include <QCryptographicHash>
+#include <QList>
 
 #include <cstdint>
+#include <vector>
 
 #include "html_scrubber_engine.h"
+#include "html_scrubber_digest.h"
+#include "html_scrubber_chunk_hash_sink.h"
+#include "html_scrubber_sim_hash_sink.h"
 
 namespace HtmlScrubber {
     /**
      * Class that can be used to generate hashes from scrubbed HTML, removing tags, whitespace, and other elements that
      * are not visible.
+     *
+     * Instances produce the cryptographic hashes supported by QCryptographicHash.  The functors that take a
+     * std::uint64_t in place of an algorithm select the non-cryptographic XXH64 hash instead, which is much faster
+     * and is sufficient for detecting changed pages.  They are provided by \ref HtmlScrubber::FastHasher, which
+     * can also be used directly for a seeded or chunked hash.
      */
     class Hasher:private Engine, public QCryptographicHash {
         public:
+            using Engine::Backend;
+            using Engine::setBackend;
+            using Engine::backend;
+            using Engine::setParallelThreadLimit;
+            using Engine::parallelThreadLimit;
+            using Engine::Utf8Policy;
+            using Engine::setUtf8Policy;
+            using Engine::utf8Policy;
+            using Engine::InputMode;
+            using Engine::inputMode;
+            using Engine::feed;
+
+            /**
+             * Type used to describe a content-defined chunk of the scrubbed data.
+             */
+            typedef ChunkHashSink::Chunk Chunk;
+
+            /**
+             * Constructor.  Use this constructor when the document will be supplied in chunks through
+             * \ref HtmlScrubber::Hasher::begin, \ref HtmlScrubber::Engine::feed, and
+             * \ref HtmlScrubber::Hasher::finish.
+             *
+             * \param[in] hashAlgorithm The hashing algorithm to be used.
+             */
+            Hasher(Algorithm hashAlgorithm);
+
             /**
              * Constructor
              *
              * \param[in] rawData       The raw data to be scrubbed and hashed.
              *
              * \param[in] hashAlgorithm The hashing algorithm to be used.
+             *
+             * \param[in] inputMode     The way the hasher accesses the raw data.
+             */
+            Hasher(const QByteArray& rawData, Algorithm hashAlgorithm, InputMode inputMode = InputMode::COPY);
+
+            /**
+             * Constructor.  The hasher scans the supplied data without copying or modifying it.
+             *
+             * \param[in] rawData       The raw data to be scrubbed and hashed.  The data must remain valid and
+             *                          unchanged until scrubbing completes.
+             *
+             * \param[in] length        The length of the raw data, in bytes.
+             *
+             * \param[in] hashAlgorithm The hashing algorithm to be used.
+             */
+            Hasher(const char* rawData, unsigned long length, Algorithm hashAlgorithm);
+
+            ~Hasher() override;
+
+            /**
+             * Method you can use to bind the hasher to a new document.  The hash context and buffers are kept, so a
+             * single hasher can process many documents without reallocating.
+             *
+             * \param[in] rawData   The raw data to be scrubbed and hashed.
+             *
+             * \param[in] inputMode The way the hasher accesses the raw data.
+             */
+            void setInput(const QByteArray& rawData, InputMode inputMode = InputMode::COPY);
+
+            /**
+             * Method you can use to bind the hasher to a new document that is scanned without being copied or
+             * modified.
+             *
+             * \param[in] rawData The raw data to be scrubbed and hashed.  The data must remain valid and unchanged
+             *                    until scrubbing completes.
+             *
+             * \param[in] length  The length of the raw data, in bytes.
+             */
+            void setInput(const char* rawData, unsigned long length);
+
+            /**
+             * Method you can use to enable hashing of content-defined chunks of the scrubbed data alongside the
+             * document hash.  Chunks are located and hashed as described for \ref HtmlScrubber::ChunkHashSink, using
+             * its default lengths.  Takes effect when the next document is started.
+             *
+             * \param[in] nowEnabled If true, chunk hashes are calculated.  If false, chunk hashes are not calculated.
+             */
+            void setChunkHashing(bool nowEnabled);
+
+            /**
+             * Method you can use to determine if chunk hashes are calculated for the next document.
+             *
+             * \return Returns true if chunk hashes are calculated.
+             */
+            bool chunkHashing() const;
+
+            /**
+             * Method you can use to obtain the chunk hashes of the last document.
+             *
+             * \return Returns the chunks, in order.  The list is empty if chunk hashing was disabled when the document
+             *         was started.
              */
-            Hasher(const QByteArray& rawData, Algorithm hashAlgorithm);
+            const std::vector<Chunk>& chunks() const;
 
-            ~Hasher();
+            /**
+             * Method you can use to enable calculation of a SimHash similarity fingerprint of the scrubbed data
+             * alongside the document hash.  The fingerprint is calculated as described for
+             * \ref HtmlScrubber::SimHashSink, using its default shingle length.  Takes effect when the next document
+             * is started.
+             *
+             * \param[in] nowEnabled If true, the fingerprint is calculated.  If false, the fingerprint is not
+             *                       calculated.
+             */
+            void setSimHashing(bool nowEnabled);
+
+            /**
+             * Method you can use to determine if the SimHash fingerprint is calculated for the next document.
+             *
+             * \return Returns true if the fingerprint is calculated.
+             */
+            bool simHashing() const;
+
+            /**
+             * Method you can use to obtain the SimHash fingerprint of the last document.  Compare fingerprints using
+             * \ref HtmlScrubber::SimHashSink::distance.
+             *
+             * \return Returns the fingerprint.  The value is 0 if the fingerprint was not calculated when the document
+             *         was started.
+             */
+            std::uint64_t simHash() const;
 
             /**
              * Method you can call to scrub HTML.
+             *
+             * \return Returns true on success, returns false on error.  An error is reported if the input contains
+             *         invalid UTF-8 and the UTF-8 policy is \ref HtmlScrubber::Engine::Utf8Policy::REJECT.
+             */
+            bool scrubAndHash();
+
+            /**
+             * Method you can call to begin scrubbing and hashing a document that is supplied in chunks.
+             */
+            void begin();
+
+            /**
+             * Method you can call once the last chunk of a document has been supplied.
+             *
+             * \return Returns the resulting cryptographic hash.  An empty array is returned if the document was
+             *         rejected.
+             */
+            QByteArray finish();
+
+            /**
+             * Method you can use to obtain the current hash as a fixed size value.  Unlike
+             * QCryptographicHash::result, no heap allocation is made when built against Qt 6.3 or later.  Earlier
+             * versions of Qt have no QCryptographicHash::resultView, so the hash is copied from
+             * QCryptographicHash::result, which allocates on each call.
+             *
+             * \return Returns the hash of the data processed so far.
              */
-            void scrubAndHash();
+            Digest digest() const;
 
             /**
              * Functor
@@ -62,9 +210,176 @@ namespace HtmlScrubber {
              *
              * \param[in] hashAlgorithm The hashing algorithm to be used.
              *
-             * \return Returns the resulting cryptographic hash.
+             * \param[in] scrubBackend  The parser back-end to be used.
+             *
+             * \param[in] scrubPolicy   The policy used for invalid UTF-8.
+             *
+             * \return Returns the resulting cryptographic hash.  An empty array is returned if the input was rejected.
+             */
+            static QByteArray scrubAndHash(
+                const QByteArray& rawData,
+                Algorithm         hashAlgorithm,
+                Backend           scrubBackend = Backend::SWITCH,
+                Utf8Policy        scrubPolicy = Utf8Policy::PASS_THROUGH
+            );
+
+            /**
+             * Functor that scrubs and hashes a document, returning the hash as a fixed size value.  The document is
+             * scanned without being copied and a hasher owned by the calling thread is reused, so, once the thread
+             * has hashed a document with the algorithm, no heap allocations are made when built against Qt 6.3 or
+             * later.  Against earlier versions of Qt, the one allocation made per document is the one made by
+             * QCryptographicHash::result, see \ref digest.  The \ref HtmlScrubber::Engine::Backend::PARALLEL
+             * back-end is the exception when it splits a document into chunks, allocating its state maps, recorded
+             * output, and threads for each document.
+             *
+             * \param[in] rawData       The raw data to be scrubbed.  The data is not copied or modified.
+             *
+             * \param[in] length        The length of the raw data, in bytes.
+             *
+             * \param[in] hashAlgorithm The hashing algorithm to be used.
+             *
+             * \param[in] scrubBackend  The parser back-end to be used.
+             *
+             * \param[in] scrubPolicy   The policy used for invalid UTF-8.
+             *
+             * \return Returns the resulting cryptographic hash.  An empty digest is returned if the input was rejected.
+             */
+            static Digest scrubAndDigest(
+                const char*   rawData,
+                unsigned long length,
+                Algorithm     hashAlgorithm,
+                Backend       scrubBackend = Backend::SWITCH,
+                Utf8Policy    scrubPolicy = Utf8Policy::PASS_THROUGH
+            );
+
+            /**
+             * Functor that scrubs and hashes a document, returning the hash as a fixed size value.
+             *
+             * \param[in] rawData       The raw data instance to be scrubbed.
+             *
+             * \param[in] hashAlgorithm The hashing algorithm to be used.
+             *
+             * \param[in] scrubBackend  The parser back-end to be used.
+             *
+             * \param[in] scrubPolicy   The policy used for invalid UTF-8.
+             *
+             * \return Returns the resulting cryptographic hash.  An empty digest is returned if the input was rejected.
+             */
+            static Digest scrubAndDigest(
+                const QByteArray& rawData,
+                Algorithm         hashAlgorithm,
+                Backend           scrubBackend = Backend::SWITCH,
+                Utf8Policy        scrubPolicy = Utf8Policy::PASS_THROUGH
+            );
+
+            /**
+             * Functor that scrubs and hashes a file.  The file is memory mapped read-only and scanned directly from
+             * the mapping without copying, so its contents are neither read into an intermediate buffer nor
+             * modified.
+             *
+             * \param[in] filename      The name of the file to be scrubbed.
+             *
+             * \param[in] hashAlgorithm The hashing algorithm to be used.
+             *
+             * \param[in] scrubBackend  The parser back-end to be used.
+             *
+             * \param[in] scrubPolicy   The policy used for invalid UTF-8.
+             *
+             * \return Returns the resulting cryptographic hash.  An empty array is returned if the file could not be
+             *         mapped or the input was rejected.
+             */
+            static QByteArray scrubAndHashFile(
+                const QString& filename,
+                Algorithm      hashAlgorithm,
+                Backend        scrubBackend = Backend::SWITCH,
+                Utf8Policy     scrubPolicy = Utf8Policy::PASS_THROUGH
+            );
+
+            /**
+             * Functor that scrubs a document and hashes it using XXH64.
+             *
+             * \param[in]  rawData      The raw data to be scrubbed.  The data is not copied or modified.
+             *
+             * \param[in]  length       The length of the raw data, in bytes.
+             *
+             * \param[out] hash         The resulting hash.  The value is unchanged if the input was rejected.
+             *
+             * \param[in]  scrubBackend The parser back-end to be used.
+             *
+             * \param[in]  scrubPolicy  The policy used for invalid UTF-8.
+             *
+             * \return Returns true on success.  Returns false if the input was rejected.
+             */
+            static bool scrubAndHash(
+                const char*    rawData,
+                unsigned long  length,
+                std::uint64_t& hash,
+                Backend        scrubBackend = Backend::SWITCH,
+                Utf8Policy     scrubPolicy = Utf8Policy::PASS_THROUGH
+            );
+
+            /**
+             * Functor that scrubs a document and hashes it using XXH64.
+             *
+             * \param[in]  rawData      The raw data instance to be scrubbed.
+             *
+             * \param[out] hash         The resulting hash.  The value is unchanged if the input was rejected.
+             *
+             * \param[in]  scrubBackend The parser back-end to be used.
+             *
+             * \param[in]  scrubPolicy  The policy used for invalid UTF-8.
+             *
+             * \return Returns true on success.  Returns false if the input was rejected.
+             */
+            static bool scrubAndHash(
+                const QByteArray& rawData,
+                std::uint64_t&    hash,
+                Backend           scrubBackend = Backend::SWITCH,
+                Utf8Policy        scrubPolicy = Utf8Policy::PASS_THROUGH
+            );
+
+            /**
+             * Functor that scrubs a memory mapped file and hashes it using XXH64.
+             *
+             * \param[in]  filename     The name of the file to be scrubbed.
+             *
+             * \param[out] hash         The resulting hash.  The value is unchanged if the file could not be mapped
+             *                          or the input was rejected.
+             *
+             * \param[in]  scrubBackend The parser back-end to be used.
+             *
+             * \param[in]  scrubPolicy  The policy used for invalid UTF-8.
+             *
+             * \return Returns true on success.  Returns false if the file could not be mapped or the input was
+             *         rejected.
+             */
+            static bool scrubAndHashFile(
+                const QString& filename,
+                std::uint64_t& hash,
+                Backend        scrubBackend = Backend::SWITCH,
+                Utf8Policy     scrubPolicy = Utf8Policy::PASS_THROUGH
+            );
+
+            /**
+             * Functor that scrubs and hashes a batch of documents.  A single hasher owned by the calling thread is
+             * reset between documents, and each document is scanned without being copied, so the hash context and
+             * buffers are allocated once rather than per document.  The hash of each document is identical to that
+             * returned by the single document functor.
+             *
+             * \param[in] rawData       The raw data instances to be scrubbed.
+             *
+             * \param[in] hashAlgorithm The hashing algorithm to be used.
+             *
+             * \param[in] scrubPolicy   The policy used for invalid UTF-8.
+             *
+             * \return Returns the resulting cryptographic hash of each document, in order.  An empty array is returned
+             *         for each document that was rejected.
              */
-            static QByteArray scrubAndHash(const QByteArray& rawData, Algorithm hashAlgorithm);
+            static QList<QByteArray> scrubAndHash(
+                const QList<QByteArray>& rawData,
+                Algorithm                hashAlgorithm,
+                Utf8Policy               scrubPolicy = Utf8Policy::PASS_THROUGH
+            );
 
         protected:
             /**
@@ -75,6 +390,63 @@ namespace HtmlScrubber {
              * \param[in] charsToCopy  The number of characters to be copied.
              */
             void update(const char* inputPointer, unsigned long charsToCopy) override;
+
+        private:
+            /**
+             * Method that returns a hasher owned by the calling thread, used by the functors so that the hash
+             * context is allocated once per thread and algorithm rather than once per document.
+             *
+             * \param[in] hashAlgorithm The hashing algorithm to be used.
+             *
+             * \return Returns a reference to the thread's hasher for the algorithm.
+             */
+            static Hasher& pooledHasher(Algorithm hashAlgorithm);
+
+            /**
+             * Method that resets the hash and sinks at the start of a document and latches the enabled calculations
+             * for the document.
+             */
+            void startDocument();
+
+            /**
+             * Method that completes the enabled chunk and similarity calculations once a document is complete.
+             */
+            void finishSinks();
+
+            /**
+             * The raw data to be scrubbed.  Holding a reference keeps read-only data valid while it is scanned.
+             */
+            QByteArray inputData;
+
+            /**
+             * Flag indicating if chunk hashes are calculated.
+             */
+            bool chunkHashingEnabled;
+
+            /**
+             * Flag indicating if chunk hashes are calculated for the current document.
+             */
+            bool chunkHashingActive;
+
+            /**
+             * Sink used to calculate chunk hashes.
+             */
+            ChunkHashSink chunkHashSink;
+
+            /**
+             * Flag indicating if the SimHash fingerprint is calculated.
+             */
+            bool simHashingEnabled;
+
+            /**
+             * Flag indicating if the SimHash fingerprint is calculated for the current document.
+             */
+            bool simHashingActive;
+
+            /**
+             * Sink used to calculate the SimHash fingerprint.
+             */
+            SimHashSink simHashSink;
     };
 };
 #endif
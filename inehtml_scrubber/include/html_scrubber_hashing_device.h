@@ -0,0 +1,171 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides a QIODevice that scrubs and hashes data written to it.
+***********************************************************************************************************************/
+
+/* .. sphinx-project inehtmlscrubber */
+
+#ifndef HTML_SCRUBBER_HASHING_DEVICE_H
+#define HTML_SCRUBBER_HASHING_DEVICE_H
+
+#include <QtGlobal>
+#include <QObject>
+#include <QByteArray>
+#include <QIODevice>
+#include <QCryptographicHash>
+
+#include "html_scrubber_hasher.h"
+
+namespace HtmlScrubber {
+    /**
+     * Write-only, sequential device that scrubs and hashes the data written to it.  Data is processed as it is
+     * written, using \ref HtmlScrubber::Hasher in streaming mode, so the document is never accumulated.  The hash is
+     * available from \ref HtmlScrubber::HashingDevice::result once the device is closed.
+     *
+     * Opening the device begins a new document.  Writes fail, and the hash is empty, once a document has been rejected
+     * under \ref HtmlScrubber::Engine::Utf8Policy::REJECT.
+     */
+    class HashingDevice:public QIODevice {
+        Q_OBJECT
+
+        public:
+            /**
+             * Type used to represent parser back-ends.
+             */
+            typedef Hasher::Backend Backend;
+
+            /**
+             * Type used to represent UTF-8 policies.
+             */
+            typedef Hasher::Utf8Policy Utf8Policy;
+
+            /**
+             * Constructor
+             *
+             * \param[in] hashAlgorithm The hashing algorithm to be used.
+             *
+             * \param[in] parent        Pointer to the parent object.
+             */
+            HashingDevice(QCryptographicHash::Algorithm hashAlgorithm, QObject* parent = nullptr);
+
+            ~HashingDevice() override;
+
+            /**
+             * Method you can use to select the parser back-end.  Takes effect when the device is next opened.
+             *
+             * \param[in] newBackend The new parser back-end.
+             */
+            void setBackend(Backend newBackend);
+
+            /**
+             * Method you can use to determine the parser back-end used when the device is next opened.
+             *
+             * \return Returns the selected parser back-end.
+             */
+            Backend backend() const;
+
+            /**
+             * Method you can use to select how invalid UTF-8 is handled.  Takes effect when the device is next
+             * opened.
+             *
+             * \param[in] newUtf8Policy The new UTF-8 policy.
+             */
+            void setUtf8Policy(Utf8Policy newUtf8Policy);
+
+            /**
+             * Method you can use to determine how invalid UTF-8 is handled when the device is next opened.
+             *
+             * \return Returns the selected UTF-8 policy.
+             */
+            Utf8Policy utf8Policy() const;
+
+            /**
+             * Method you can use to open the device.  The device only supports writing.
+             *
+             * \param[in] mode The open mode.  Must be write only.
+             *
+             * \return Returns true on success.  Returns false if the mode includes reading.
+             */
+            bool open(OpenMode mode) override;
+
+            /**
+             * Method you can use to close the device, completing the hash.
+             */
+            void close() override;
+
+            /**
+             * Method that indicates the device is sequential.
+             *
+             * \return Returns true.
+             */
+            bool isSequential() const override;
+
+            /**
+             * Method you can use to obtain the hash of the scrubbed data.
+             *
+             * \return Returns the hash of the last document written to the device.  An empty array is returned if
+             *         the device has not been closed since it was last opened or if the document was rejected.
+             */
+            QByteArray result() const;
+
+        protected:
+            /**
+             * Method called to read data.  Reading is not supported.
+             *
+             * \param[in] data    Pointer to the buffer to receive the data.
+             *
+             * \param[in] maxSize The maximum number of bytes to read.
+             *
+             * \return Returns -1.
+             */
+            qint64 readData(char* data, qint64 maxSize) override;
+
+            /**
+             * Method called to write data.
+             *
+             * \param[in] data    Pointer to the data to be scrubbed and hashed.
+             *
+             * \param[in] maxSize The number of bytes to be written.
+             *
+             * \return Returns the number of bytes written.  Returns -1 if the document has been rejected.
+             */
+            qint64 writeData(const char* data, qint64 maxSize) override;
+
+        private:
+            /**
+             * The hasher used to scrub and hash the data.
+             */
+            Hasher currentHasher;
+
+            /**
+             * The parser back-end applied when the device is next opened.
+             */
+            Backend currentBackend;
+
+            /**
+             * The UTF-8 policy applied when the device is next opened.
+             */
+            Utf8Policy currentUtf8Policy;
+
+            /**
+             * The hash of the last completed document.
+             */
+            QByteArray currentResult;
+    };
+};
+#endif
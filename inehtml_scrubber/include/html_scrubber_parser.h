@@ -24,6 +24,7 @@
 #define INEHTML_SCRUBBER_PARSER
 
 #include <cassert>
+#include <cctype>
 
 namespace HtmlScrubber {
     /**
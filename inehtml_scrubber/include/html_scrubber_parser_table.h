@@ -0,0 +1,303 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides a table driven representation of the \ref HtmlScrubber::Parser state machine.
+***********************************************************************************************************************/
+
+/* .. sphinx-project inehtmlscrubber */
+
+#ifndef HTML_SCRUBBER_PARSER_TABLE_H
+#define HTML_SCRUBBER_PARSER_TABLE_H
+
+#include <cstdint>
+
+#include "html_scrubber_parser.h"
+
+namespace HtmlScrubber {
+    /**
+     * Class that holds a compile-time transition table equivalent to \ref HtmlScrubber::Parser::parse.
+     *
+     * Input bytes are first reduced to a small number of byte classes.  Every byte within a class behaves identically
+     * in every parser state so the transition table only needs one column per class rather than one per byte value.
+     * Each table entry holds the next state and the transition hook, if any, that fires on that transition.
+     *
+     * Whitespace is classified using the rules of the "C" locale.
+     *
+     * The tests/parser_check target, run with "make check", compares every table entry against
+     * \ref HtmlScrubber::Parser.
+     */
+    class ParserTable {
+        public:
+            /**
+             * Type used to represent parser states.
+             */
+            typedef Parser::States States;
+
+            /**
+             * Enumeration of byte classes.
+             */
+            enum class ByteClass : std::uint8_t {
+                /**
+                 * Indicates a byte that never triggers a state specific transition.
+                 */
+                OTHER,
+
+                /**
+                 * Indicates a whitespace character, space, tab, newline, vertical tab, form feed, or carriage return.
+                 */
+                WHITESPACE,
+
+                /**
+                 * Indicates a '<' character.
+                 */
+                LESS_THAN,
+
+                /**
+                 * Indicates a '>' character.
+                 */
+                GREATER_THAN,
+
+                /**
+                 * Indicates a '/' character.
+                 */
+                SLASH,
+
+                /**
+                 * Indicates an '=' character.
+                 */
+                EQUALS,
+
+                /**
+                 * Indicates a '"' character.
+                 */
+                DOUBLE_QUOTE,
+
+                /**
+                 * Indicates a '\'' character.
+                 */
+                SINGLE_QUOTE,
+
+                /**
+                 * Indicates a '?' character.
+                 */
+                QUESTION_MARK,
+
+                /**
+                 * Indicates a lower case 's'.  Tag names are only recognized starting with a lower case 's'.
+                 */
+                LOWER_S,
+
+                /**
+                 * Indicates an upper case 'S'.
+                 */
+                UPPER_S,
+
+                /**
+                 * Indicates an 'r' or 'R' character.
+                 */
+                LETTER_R,
+
+                /**
+                 * Indicates a 'c' or 'C' character.
+                 */
+                LETTER_C,
+
+                /**
+                 * Indicates an 'h' or 'H' character.
+                 */
+                LETTER_H,
+
+                /**
+                 * Indicates an 'e' or 'E' character.
+                 */
+                LETTER_E,
+
+                /**
+                 * Indicates an 'f' or 'F' character.
+                 */
+                LETTER_F,
+
+                /**
+                 * Indicates an 'i' or 'I' character.
+                 */
+                LETTER_I,
+
+                /**
+                 * Indicates a 't' or 'T' character.
+                 */
+                LETTER_T,
+
+                /**
+                 * Indicates a 'p' or 'P' character.
+                 */
+                LETTER_P,
+
+                /**
+                 * Indicates a 'y' or 'Y' character.
+                 */
+                LETTER_Y,
+
+                /**
+                 * Indicates an 'l' or 'L' character.
+                 */
+                LETTER_L,
+
+                NUMBER_BYTE_CLASSES
+            };
+
+            /**
+             * Enumeration of transition hooks.  Values map one-to-one onto the virtual transition methods in
+             * \ref HtmlScrubber::Parser.
+             */
+            enum class Hook : std::uint8_t {
+                NONE,
+                START_TAG,
+                MULTIPLE_WHITE_SPACE,
+                WHITESPACE,
+                RESUME_TEXT,
+                END_TAG,
+                START_SRC_ATTRIBUTE,
+                END_SRC_ATTRIBUTE,
+                START_HREF_ATTRIBUTE,
+                END_HREF_ATTRIBUTE,
+                START_CITE_ATTRIBUTE,
+                END_CITE_ATTRIBUTE,
+                START_SCRIPT_SRC_ATTRIBUTE,
+                END_SCRIPT_SRC_ATTRIBUTE,
+                START_STYLE,
+                END_STYLE
+            };
+
+            /**
+             * Structure holding a single transition table entry.
+             */
+            struct Transition {
+                /**
+                 * The next state, stored as a byte to keep the table compact.
+                 */
+                std::uint8_t nextState;
+
+                /**
+                 * The hook that fires on this transition.
+                 */
+                Hook hook;
+            };
+
+            /**
+             * The number of parser states.
+             */
+            static constexpr unsigned numberStates = static_cast<unsigned>(States::NUMBER_STATES);
+
+            /**
+             * The number of byte classes.
+             */
+            static constexpr unsigned numberByteClasses = static_cast<unsigned>(ByteClass::NUMBER_BYTE_CLASSES);
+
+            /**
+             * Method you can use to determine the class of a byte.
+             *
+             * \param[in] c The byte to be classified.
+             *
+             * \return Returns the byte class.
+             */
+            static inline ByteClass byteClass(char c) {
+                return byteClasses.entries[static_cast<std::uint8_t>(c)];
+            }
+
+            /**
+             * Method you can use to look up a transition.
+             *
+             * \param[in] state The current parser state.
+             *
+             * \param[in] c     The byte that is being parsed.
+             *
+             * \return Returns the transition to be taken.
+             */
+            static inline const Transition& transition(States state, char c) {
+                return transitions.entries[static_cast<unsigned>(state)][static_cast<unsigned>(byteClass(c))];
+            }
+
+        private:
+            /**
+             * Structure holding the byte class of every byte value.
+             */
+            struct ByteClassTable {
+                ByteClass entries[256];
+            };
+
+            /**
+             * Structure holding the transitions indexed by state and byte class.
+             */
+            struct TransitionTable {
+                Transition entries[numberStates][numberByteClasses];
+            };
+
+            /**
+             * Method that classifies a single byte.
+             *
+             * \param[in] c The byte to be classified.
+             *
+             * \return Returns the byte class.
+             */
+            static constexpr ByteClass classify(char c);
+
+            /**
+             * Method that returns a byte belonging to a given byte class.
+             *
+             * \param[in] byteClass The byte class of interest.
+             *
+             * \return Returns a byte from the requested class.
+             */
+            static constexpr char representative(ByteClass byteClass);
+
+            /**
+             * Method that mirrors \ref HtmlScrubber::Parser::parse for a single state and byte.
+             *
+             * \param[in] state The current state.
+             *
+             * \param[in] c     The byte being parsed.
+             *
+             * \return Returns the resulting transition.
+             */
+            static constexpr Transition nextTransition(States state, char c);
+
+            /**
+             * Method that builds the byte class table.
+             *
+             * \return Returns the byte class table.
+             */
+            static constexpr ByteClassTable buildByteClasses();
+
+            /**
+             * Method that builds the transition table.
+             *
+             * \return Returns the transition table.
+             */
+            static constexpr TransitionTable buildTransitions();
+
+            /**
+             * Table mapping byte values to byte classes.
+             */
+            static const ByteClassTable byteClasses;
+
+            /**
+             * Table of transitions indexed by state and byte class.
+             */
+            static const TransitionTable transitions;
+    };
+};
+#endif
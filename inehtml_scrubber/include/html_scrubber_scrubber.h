@@ -28,8 +28,11 @@
 #include <QString>
 
 #include <cstdint>
+#include <limits>
+#include <vector>
 
 #include "html_scrubber_engine.h"
+#include "html_scrubber_span_sink.h"
 
 namespace HtmlScrubber {
     /**
@@ -38,38 +41,216 @@ namespace HtmlScrubber {
      */
     class Scrubber:private Engine {
         public:
+            using Engine::Backend;
+            using Engine::setBackend;
+            using Engine::backend;
+            using Engine::setParallelThreadLimit;
+            using Engine::parallelThreadLimit;
+            using Engine::Utf8Policy;
+            using Engine::setUtf8Policy;
+            using Engine::utf8Policy;
+            using Engine::InputMode;
+            using Engine::inputMode;
+            using Engine::feed;
+
+            /**
+             * Type used to represent spans of scrubbed data.
+             */
+            typedef SpanSink::Span Span;
+
+            /**
+             * The largest output, in bytes, held in a QByteArray.  QByteArray sizes are ints and the allocation also
+             * holds a small header.
+             */
+            static constexpr unsigned long maximumOutputSize = std::numeric_limits<int>::max() - 64UL;
+
+            /**
+             * Enumeration of the ways the scrubber can hold its output.
+             */
+            enum class OutputMode {
+                /**
+                 * Indicates the scrubbed data should be copied into the output as it is generated.
+                 */
+                MATERIALIZED,
+
+                /**
+                 * Indicates \ref HtmlScrubber::Scrubber::scrub should record spans referring to the input data, and
+                 * to small constant tables for synthesized bytes, rather than copying the scrubbed data.  The output
+                 * is only materialized if \ref HtmlScrubber::Scrubber::output is called.  The spans remain valid while
+                 * the input data does.  Documents supplied in chunks are always materialized.
+                 */
+                SPANS
+            };
+
+            /**
+             * Constructor.  Use this constructor when the document will be supplied in chunks through
+             * \ref HtmlScrubber::Scrubber::begin, \ref HtmlScrubber::Engine::feed, and
+             * \ref HtmlScrubber::Scrubber::finish.
+             */
+            Scrubber();
+
             /**
              * Constructor
              *
-             * \param[in] rawData The raw data to be scrubbed.  Data will be modified, in place when scrubbed.
+             * \param[in] rawData   The raw data to be scrubbed.  In copy mode, data will be modified, in place when
+             *                      scrubbed.
+             *
+             * \param[in] inputMode The way the scrubber accesses the raw data.
+             */
+            Scrubber(const QByteArray& rawData, InputMode inputMode = InputMode::COPY);
+
+            /**
+             * Constructor.  The scrubber scans the supplied data without copying or modifying it.
+             *
+             * \param[in] rawData The raw data to be scrubbed.  The data must remain valid and unchanged until
+             *                    scrubbing completes.
+             *
+             * \param[in] length  The length of the raw data, in bytes.
+             */
+            Scrubber(const char* rawData, unsigned long length);
+
+            ~Scrubber() override;
+
+            /**
+             * Method you can use to bind the scrubber to a new document.  The output buffer, including its capacity,
+             * and settings are kept, so a single scrubber can process many documents without reallocating once the
+             * output buffer has grown to fit the largest document.
+             *
+             * \param[in] rawData   The raw data to be scrubbed.
+             *
+             * \param[in] inputMode The way the scrubber accesses the raw data.
              */
-            Scrubber(const QByteArray& rawData);
+            void setInput(const QByteArray& rawData, InputMode inputMode = InputMode::COPY);
 
-            ~Scrubber();
+            /**
+             * Method you can use to bind the scrubber to a new document that is scanned without being copied or
+             * modified.
+             *
+             * \param[in] rawData The raw data to be scrubbed.  The data must remain valid and unchanged until
+             *                    scrubbing completes.
+             *
+             * \param[in] length  The length of the raw data, in bytes.
+             */
+            void setInput(const char* rawData, unsigned long length);
 
             /**
-             * Method you can call to scrub HTML.
+             * Method you can call to scrub HTML.  The output buffer keeps its capacity between documents and is
+             * sized up front to \ref HtmlScrubber::Engine::maximumOutputLength.  Scrubbed data is copied straight
+             * into it, without staging, and the buffer is truncated to the scrubbed length once done.
              *
-             * \return Returns true on success, returns false on error.
+             * \return Returns true on success, returns false on error.  An error is reported if the input contains
+             *         invalid UTF-8 and the UTF-8 policy is \ref HtmlScrubber::Engine::Utf8Policy::REJECT, or if the
+             *         output may not fit in a QByteArray.
              */
-            void scrub();
+            bool scrub();
 
             /**
              * Functor
              *
-             * \param[in] rawData The raw data instance to be scrubbed.
+             * \param[in] rawData       The raw data instance to be scrubbed.
+             *
+             * \param[in] scrubBackend  The parser back-end to be used.
+             *
+             * \param[in] scrubPolicy   The policy used for invalid UTF-8.
+             *
+             * \return Returns the resulting scrubbed data.  An empty array is returned if the input was rejected.
+             */
+            static QByteArray scrub(
+                const QByteArray& rawData,
+                Backend           scrubBackend = Backend::SWITCH,
+                Utf8Policy        scrubPolicy = Utf8Policy::PASS_THROUGH
+            );
+
+            /**
+             * Functor that scrubs into a caller supplied buffer.  The buffer's existing capacity is reused, so a
+             * caller that passes the same buffer for every document performs no output allocations once the buffer
+             * has grown to fit the largest document.
+             *
+             * \param[in]     rawData      The raw data instance to be scrubbed.
+             *
+             * \param[in,out] output       The buffer to receive the scrubbed data.  Any existing contents are
+             *                             discarded.  The buffer is left empty if the input was rejected.
+             *
+             * \param[in]     scrubBackend The parser back-end to be used.
              *
-             * \return Returns the resulting scrubbed data.
+             * \param[in]     scrubPolicy  The policy used for invalid UTF-8.
+             *
+             * \return Returns true on success, returns false if the input was rejected.
              */
-            static QByteArray scrub(const QByteArray& rawData);
+            static bool scrub(
+                const QByteArray& rawData,
+                QByteArray&       output,
+                Backend           scrubBackend = Backend::SWITCH,
+                Utf8Policy        scrubPolicy = Utf8Policy::PASS_THROUGH
+            );
 
             /**
-             * Method you can use to obtain the current output data instance.
+             * Functor that scrubs a buffer in place, replacing its contents with the scrubbed data.  The output is
+             * compacted over the front of the input, so peak memory is about the size of the document.  The array
+             * is first grown by \ref HtmlScrubber::Engine::paddingLength bytes, plus the growth caused by replacement
+             * characters under \ref HtmlScrubber::Engine::Utf8Policy::REPLACE, and is detached if it is shared.
+             *
+             * \param[in,out] data         The raw data to be scrubbed.  On success, holds the scrubbed data.  The data
+             *                             is left unchanged if it was rejected.
+             *
+             * \param[in]     scrubBackend The parser back-end to be used.
+             *
+             * \param[in]     scrubPolicy  The policy used for invalid UTF-8.
+             *
+             * \return Returns true on success, returns false if the input was rejected or the output may not fit in
+             *         a QByteArray.
+             */
+            static bool scrubInPlace(
+                QByteArray& data,
+                Backend     scrubBackend = Backend::SWITCH,
+                Utf8Policy  scrubPolicy = Utf8Policy::PASS_THROUGH
+            );
+
+            /**
+             * Method you can call to begin scrubbing a document that is supplied in chunks.
+             */
+            void begin();
+
+            /**
+             * Method you can call once the last chunk of a document has been supplied.
+             *
+             * \return Returns the resulting scrubbed data.  An empty array is returned if the document was rejected.
+             */
+            QByteArray finish();
+
+            /**
+             * Method you can use to select how the scrubber holds its output.
+             *
+             * \param[in] newOutputMode The new output mode.
+             */
+            void setOutputMode(OutputMode newOutputMode);
+
+            /**
+             * Method you can use to determine how the scrubber holds its output.
+             *
+             * \return Returns the current output mode.
+             */
+            OutputMode outputMode() const;
+
+            /**
+             * Method you can use to obtain the current output data instance.  In
+             * \ref HtmlScrubber::Scrubber::OutputMode::SPANS mode, the spans are copied into the output the first time
+             * this method is called after scrubbing.  The output is left empty if the spans do not fit in a
+             * QByteArray.
              *
              * \return Returns a reference to the raw output data instance.
              */
             const QByteArray& output() const;
 
+            /**
+             * Method you can use to obtain the spans recorded in \ref HtmlScrubber::Scrubber::OutputMode::SPANS mode.
+             * The spans can be passed to writev, hashed, or compared without materializing the output.
+             *
+             * \return Returns the spans making up the scrubbed data, in order.  The list is empty if the output was
+             *         materialized as it was generated.
+             */
+            const std::vector<Span>& spans() const;
+
         protected:
             /**
              * Method you can overload to modify how the scrubber operates on supplied raw data.
@@ -81,10 +262,46 @@ namespace HtmlScrubber {
             void update(const char* inputPointer, unsigned long charsToCopy) override;
 
         private:
+            /**
+             * The raw data to be scrubbed.  Holding a reference keeps read-only data valid while it is scanned.
+             */
+            QByteArray inputData;
+
+            /**
+             * The selected output mode.
+             */
+            OutputMode currentOutputMode;
+
+            /**
+             * Flag indicating the current document is being recorded as spans.
+             */
+            bool recordingSpans;
+
+            /**
+             * The spans recorded for the current document.
+             */
+            SpanSink outputSpans;
+
+            /**
+             * Flag indicating the recorded spans have been copied into the output data.
+             */
+            mutable bool outputMaterialized;
+
             /**
              * The resulting output data.
              */
-            QByteArray outputData;
+            mutable QByteArray outputData;
+
+            /**
+             * Pointer to the output data while a document is scrubbed directly into it.  A null pointer indicates
+             * scrubbed data is appended to the output data.
+             */
+            char* outputPointer;
+
+            /**
+             * The number of bytes written through the output pointer.
+             */
+            unsigned long outputLength;
     };
 };
 #endif
@@ -0,0 +1,160 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides a sink that calculates a SimHash similarity fingerprint of scrubbed data.
+***********************************************************************************************************************/
+
+/* .. sphinx-project inehtmlscrubber */
+
+#ifndef HTML_SCRUBBER_SIM_HASH_SINK_H
+#define HTML_SCRUBBER_SIM_HASH_SINK_H
+
+#include <cstdint>
+
+#include "html_scrubber_sink.h"
+
+namespace HtmlScrubber {
+    /**
+     * Sink that calculates a 64-bit SimHash fingerprint, as described by Charikar, "Similarity Estimation Techniques
+     * from Rounding Algorithms", over word shingles of the scrubbed data.
+     *
+     * The data is divided into words at whitespace and control characters.  Each run of \ref shingleLength
+     * consecutive words is hashed and every bit of the shingle hash votes on the matching bit of the fingerprint.
+     * Documents sharing most of their shingles have fingerprints differing in few bits, so the Hamming distance
+     * between the fingerprints of two versions of a page, from \ref HtmlScrubber::SimHashSink::distance, estimates how
+     * much the page changed.
+     *
+     * Call \ref HtmlScrubber::SimHashSink::finish once the document is complete to count the last word.  This class
+     * does not depend on Qt.
+     */
+    class SimHashSink:public Sink {
+        public:
+            /**
+             * The default number of words in a shingle.
+             */
+            static constexpr unsigned defaultShingleLength = 3;
+
+            /**
+             * The largest supported number of words in a shingle.
+             */
+            static constexpr unsigned maximumShingleLength = 8;
+
+            /**
+             * Constructor
+             *
+             * \param[in] shingleLength The number of words in a shingle, from 1 to \ref maximumShingleLength.
+             */
+            SimHashSink(unsigned shingleLength = defaultShingleLength);
+
+            ~SimHashSink() override;
+
+            /**
+             * Method called with each run of scrubbed data, in order.
+             *
+             * \param[in] data   Pointer to the scrubbed data.
+             *
+             * \param[in] length The length of the scrubbed data, in bytes.
+             */
+            void update(const char* data, unsigned long length) override;
+
+            /**
+             * Method you can use to restart the fingerprint before reusing the sink for another document.
+             */
+            void clear();
+
+            /**
+             * Method you can call once the document is complete.  Counts the last word and, for documents shorter
+             * than a shingle, the single partial shingle.
+             */
+            void finish();
+
+            /**
+             * Method you can use to obtain the fingerprint.
+             *
+             * \return Returns the SimHash fingerprint.  The fingerprint of a document without words is 0.
+             */
+            std::uint64_t result() const;
+
+            /**
+             * Method you can use to obtain the number of words in a shingle.
+             *
+             * \return Returns the shingle length, in words.
+             */
+            unsigned shingleLength() const;
+
+            /**
+             * Method that calculates the Hamming distance between two fingerprints.
+             *
+             * \param[in] fingerprint1 The first fingerprint.
+             *
+             * \param[in] fingerprint2 The second fingerprint.
+             *
+             * \return Returns the number of bits that differ, from 0 for near duplicates to 64.
+             */
+            static unsigned distance(std::uint64_t fingerprint1, std::uint64_t fingerprint2);
+
+        private:
+            /**
+             * Method that ends the current word, if any.
+             */
+            void closeWord();
+
+            /**
+             * Method that adds the current shingle to the fingerprint.
+             *
+             * \param[in] numberWords The number of words in the shingle.
+             */
+            void addShingle(unsigned numberWords);
+
+            /**
+             * The number of words in a shingle.
+             */
+            unsigned currentShingleLength;
+
+            /**
+             * The hash of the word being read.
+             */
+            std::uint64_t wordHash;
+
+            /**
+             * The number of bytes in the word being read.
+             */
+            unsigned long wordLength;
+
+            /**
+             * The total number of words read.
+             */
+            unsigned long numberWords;
+
+            /**
+             * The hashes of the most recent words, used as a ring buffer.
+             */
+            std::uint64_t recentWords[maximumShingleLength];
+
+            /**
+             * The number of shingles added to the fingerprint.
+             */
+            unsigned long numberShingles;
+
+            /**
+             * The number of shingle hashes with each bit set.  A fingerprint bit is set when the bit was set in more
+             * than half of the shingle hashes.
+             */
+            std::uint32_t setBits[64];
+    };
+};
+#endif
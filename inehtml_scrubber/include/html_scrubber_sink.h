@@ -0,0 +1,56 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides the interface used to receive scrubbed data.
+***********************************************************************************************************************/
+
+/* .. sphinx-project inehtmlscrubber */
+
+#ifndef HTML_SCRUBBER_SINK_H
+#define HTML_SCRUBBER_SINK_H
+
+namespace HtmlScrubber {
+    /**
+     * Pure virtual class that receives scrubbed data from \ref HtmlScrubber::Engine.  This class does not depend on
+     * Qt.
+     */
+    class Sink {
+        public:
+            virtual ~Sink();
+
+            /**
+             * Method that indicates if the sink keeps the pointers passed to \ref HtmlScrubber::Sink::update rather
+             * than consuming the data during the call.  The engine disables staging for such sinks so that every
+             * pointer refers to the input data or to constant data.  The default implementation returns false.
+             *
+             * \return Returns true if the sink retains the pointers passed to it.
+             */
+            virtual bool retainsData() const;
+
+            /**
+             * Method called with each run of scrubbed data, in order.  Short consecutive runs may be combined into a
+             * single call.
+             *
+             * \param[in] data   Pointer to the scrubbed data.  Unless the sink retains data, the pointer is only
+             *                   valid for the duration of the call.
+             *
+             * \param[in] length The length of the scrubbed data, in bytes.
+             */
+            virtual void update(const char* data, unsigned long length) = 0;
+    };
+};
+#endif
@@ -0,0 +1,116 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides a sink that records the scrubbed data as a list of spans.
+***********************************************************************************************************************/
+
+/* .. sphinx-project inehtmlscrubber */
+
+#ifndef HTML_SCRUBBER_SPAN_SINK_H
+#define HTML_SCRUBBER_SPAN_SINK_H
+
+#include <vector>
+
+#include "html_scrubber_sink.h"
+
+namespace HtmlScrubber {
+    /**
+     * Sink that records the scrubbed data as a scatter-gather list of spans rather than copying it.  Spans refer
+     * either to the input data or, for bytes the scrubber synthesizes such as collapsed whitespace, attribute markers,
+     * and replacement characters, to small constant tables.  Adjacent spans that are contiguous in memory are merged.
+     *
+     * The spans remain valid while the input data does.  In \ref HtmlScrubber::Engine::InputMode::COPY mode the spans
+     * refer to the engine's own copy and so remain valid until the engine is destroyed or scrubs again.  This sink
+     * can not be used with documents supplied in chunks.
+     */
+    class SpanSink:public Sink {
+        public:
+            /**
+             * Structure describing a single span of scrubbed data.
+             */
+            struct Span {
+                /**
+                 * Pointer to the first byte of the span.
+                 */
+                const char* data;
+
+                /**
+                 * The length of the span, in bytes.
+                 */
+                unsigned long length;
+            };
+
+            SpanSink();
+
+            ~SpanSink() override;
+
+            /**
+             * Method that indicates the sink retains the pointers passed to it.
+             *
+             * \return Returns true.
+             */
+            bool retainsData() const override;
+
+            /**
+             * Method called with each run of scrubbed data, in order.
+             *
+             * \param[in] data   Pointer to the scrubbed data.
+             *
+             * \param[in] length The length of the scrubbed data, in bytes.
+             */
+            void update(const char* data, unsigned long length) override;
+
+            /**
+             * Method you can use to discard the recorded spans.
+             */
+            void clear();
+
+            /**
+             * Method you can use to obtain the recorded spans.
+             *
+             * \return Returns the spans, in order.
+             */
+            const std::vector<Span>& spans() const;
+
+            /**
+             * Method you can use to determine the total length of the scrubbed data.
+             *
+             * \return Returns the sum of the span lengths, in bytes.
+             */
+            unsigned long length() const;
+
+            /**
+             * Method you can use to materialize the scrubbed data.
+             *
+             * \param[in] destination Pointer to the buffer to receive the data.  The buffer must hold at least
+             *                        \ref HtmlScrubber::SpanSink::length bytes.
+             */
+            void copyTo(char* destination) const;
+
+        private:
+            /**
+             * The recorded spans.
+             */
+            std::vector<Span> currentSpans;
+
+            /**
+             * The total length of the recorded spans.
+             */
+            unsigned long currentLength;
+    };
+};
+#endif
@@ -0,0 +1,1224 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides a statically dispatched variant of the \ref HtmlScrubber::Parser base class.
+*
+* This header is generated from html_scrubber_parser.h by tools/generate_static_parser.py.  Do not edit it by hand.
+***********************************************************************************************************************/
+
+/* .. sphinx-project inehtml_parser */
+
+#ifndef INEHTML_SCRUBBER_STATIC_PARSER
+#define INEHTML_SCRUBBER_STATIC_PARSER
+
+#include <cassert>
+#include <cctype>
+
+#include "html_scrubber_parser.h"
+#include "html_scrubber_parser_table.h"
+
+namespace HtmlScrubber {
+    /**
+     * Parser base class using the curiously recurring template pattern.
+     *
+     * This class implements the same state machine as \ref HtmlScrubber::Parser but calls transition methods on the
+     * derived class directly rather than through the virtual table, allowing the compiler to inline them into the
+     * state machine.  Derived classes hide the default transition methods they wish to handle.  Derived classes that
+     * declare their transition methods private must declare StaticParser<Derived> as a friend.
+     *
+     * \param Derived The derived class.
+     */
+    template<typename Derived> class StaticParser {
+        public:
+            /**
+             * States.
+             */
+            typedef Parser::States States;
+
+        private:
+            /**
+             * The current state.
+             */
+            States currentState;
+
+        public:
+            /**
+             * Constructor.
+             */
+            StaticParser(): currentState(States::IN_TEXT_SPACE) {}
+
+            ~StaticParser() {}
+
+        protected:
+            /**
+             * Method you can use to determine the current state.
+             *
+             * \return Returns the current state.
+             */
+            inline States state() const {
+                return currentState;
+            }
+
+            /**
+             * Method you can use to parse the next value.
+             *
+             * \param[in,out] c The value to be parsed.  Called transition function can modify the value.
+             */
+            inline void parse(char& c) {
+                switch (currentState) {
+                    case States::IN_TEXT_SPACE: {
+                        if (c == '<') {
+                            derived().startTag(currentState, States::IN_TAG_START, c);
+                            currentState = States::IN_TAG_START;
+                        } else if (std::isspace(c)) {
+                            derived().multipleWhiteSpace(currentState, States::IN_TEXT_MULTIPLE_SPACE, c);
+                            currentState = States::IN_TEXT_MULTIPLE_SPACE;
+                        } else if (c != '<' && !std::isspace(c)) {
+                            derived().resumeText(currentState, States::IN_TEXT, c);
+                            currentState = States::IN_TEXT;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TEXT_MULTIPLE_SPACE: {
+                        if (c == '<') {
+                            derived().startTag(currentState, States::IN_TAG_START, c);
+                            currentState = States::IN_TAG_START;
+                        } else if (c != '<' && !std::isspace(c)) {
+                            derived().resumeText(currentState, States::IN_TEXT, c);
+                            currentState = States::IN_TEXT;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TEXT: {
+                        if (c == '<') {
+                            derived().startTag(currentState, States::IN_TAG_START, c);
+                            currentState = States::IN_TAG_START;
+                        } else if (std::isspace(c)) {
+                            derived().whitespace(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_START: {
+                        if (c == '/') {
+                            currentState = States::IN_TAG_SLASH;
+                        } else if (c == 's') {
+                            currentState = States::IN_TAG_S;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SEARCH: {
+                        if (c == '>') {
+                            derived().endTag(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_TAG_SPACE;
+                        } else if (c == '"') {
+                            currentState = States::IN_TAG_QUOTE;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_QUOTE: {
+                        if (c == '"') {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SPACE: {
+                        if (c == '>') {
+                            derived().endTag(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (c == 's' || c == 'S') {
+                            currentState = States::IN_TAG_SPACE_S;
+                        } else if (c == 'h' || c == 'H') {
+                            currentState = States::IN_TAG_SPACE_H;
+                        } else if (c == 'c' || c == 'C') {
+                            currentState = States::IN_TAG_SPACE_C;
+                        } else if (!std::isspace(c)) {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SLASH: {
+                        if (c == '>') {
+                            currentState = States::IN_TEXT_SPACE;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SPACE_S: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (c == 'r' || c == 'R') {
+                            currentState = States::IN_TAG_SPACE_SR;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SPACE_SR: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (c == 'c' || c == 'C') {
+                            currentState = States::IN_TAG_SPACE_SRC;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SPACE_SRC: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_TAG_SPACE_SRC;
+                        } else if (c == '=') {
+                            currentState = States::IN_TAG_SPACE_SRC_EQUALS;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SPACE_SRC_EQUALS: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_TAG_SPACE_SRC_EQUALS;
+                        } else if (c == '"' || c == '\'') {
+                            derived().startSrcAttribute(currentState, States::IN_TAG_SPACE_SRC_EQUALS_QUOTE, c);
+                            currentState = States::IN_TAG_SPACE_SRC_EQUALS_QUOTE;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SPACE_SRC_EQUALS_QUOTE: {
+                        if (c == '"' || c == '\'') {
+                            derived().endSrcAttribute(currentState, States::IN_TAG_SEARCH, c);
+                            currentState = States::IN_TAG_SEARCH;
+                        } else if (c == '?') {
+                            derived().endSrcAttribute(currentState, States::IN_TAG_SPACE_SRC_EQUALS_QUOTE_QM, c);
+                            currentState = States::IN_TAG_SPACE_SRC_EQUALS_QUOTE_QM;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SPACE_SRC_EQUALS_QUOTE_QM: {
+                        if (c == '"' || c == '\'') {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SPACE_H: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (c == 'r' || c == 'R') {
+                            currentState = States::IN_TAG_SPACE_HR;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SPACE_HR: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (c == 'e' || c == 'E') {
+                            currentState = States::IN_TAG_SPACE_HRE;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SPACE_HRE: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (c == 'f' || c == 'F') {
+                            currentState = States::IN_TAG_SPACE_HREF;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SPACE_HREF: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_TAG_SPACE_HREF;
+                        } else if (c == '=') {
+                            currentState = States::IN_TAG_SPACE_HREF_EQUALS;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SPACE_HREF_EQUALS: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_TAG_SPACE_HREF_EQUALS;
+                        } else if (c == '"' || c == '\'') {
+                            derived().startHrefAttribute(currentState, States::IN_TAG_SPACE_HREF_EQUALS_QUOTE, c);
+                            currentState = States::IN_TAG_SPACE_HREF_EQUALS_QUOTE;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SPACE_HREF_EQUALS_QUOTE: {
+                        if (c == '"' || c == '\'') {
+                            derived().endHrefAttribute(currentState, States::IN_TAG_SEARCH, c);
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SPACE_C: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (c == 'i' || c == 'I') {
+                            currentState = States::IN_TAG_SPACE_CI;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SPACE_CI: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (c == 't' || c == 'T') {
+                            currentState = States::IN_TAG_SPACE_CIT;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SPACE_CIT: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (c == 'e' || c == 'E') {
+                            currentState = States::IN_TAG_SPACE_CITE;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SPACE_CITE: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_TAG_SPACE_CITE;
+                        } else if (c == '=') {
+                            currentState = States::IN_TAG_SPACE_CITE_EQUALS;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SPACE_CITE_EQUALS: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_TAG_SPACE_CITE_EQUALS;
+                        } else if (c == '"' || c == '\'') {
+                            derived().startCiteAttribute(currentState, States::IN_TAG_SPACE_CITE_EQUALS_QUOTE, c);
+                            currentState = States::IN_TAG_SPACE_CITE_EQUALS_QUOTE;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SPACE_CITE_EQUALS_QUOTE: {
+                        if (c == '"' || c == '\'') {
+                            derived().endCiteAttribute(currentState, States::IN_TAG_SEARCH, c);
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_S: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (c == 'c' || c == 'C') {
+                            currentState = States::IN_TAG_SC;
+                        } else if (c == 't' || c == 'T') {
+                            currentState = States::IN_TAG_ST;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_TAG_SPACE;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SC: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (c == 'r' || c == 'R') {
+                            currentState = States::IN_TAG_SCR;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_TAG_SPACE;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SCR: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (c == 'i' || c == 'I') {
+                            currentState = States::IN_TAG_SCRI;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_TAG_SPACE;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SCRI: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (c == 'p' || c == 'P') {
+                            currentState = States::IN_TAG_SCRIP;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_TAG_SPACE;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SCRIP: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (c == 't' || c == 'T') {
+                            currentState = States::IN_TAG_SCRIPT;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_TAG_SPACE;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SCRIPT: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_TAG_SCRIPT_SPACE;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SCRIPT_SPACE: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_TAG_SCRIPT_SPACE;
+                        } else if (c == 's' || c == 'S') {
+                            currentState = States::IN_TAG_SCRIPT_SPACE_S;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SCRIPT_SPACE_S: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_TAG_SCRIPT_SPACE;
+                        } else if (c == 'r' || c == 'R') {
+                            currentState = States::IN_TAG_SCRIPT_SPACE_SR;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SCRIPT_SPACE_SR: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_TAG_SCRIPT_SPACE;
+                        } else if (c == 'c' || c == 'C') {
+                            currentState = States::IN_TAG_SCRIPT_SPACE_SRC;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SCRIPT_SPACE_SRC: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_TAG_SCRIPT_SPACE_SRC;
+                        } else if (c == '=') {
+                            currentState = States::IN_TAG_SCRIPT_SPACE_SRC_EQUALS;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SCRIPT_SPACE_SRC_EQUALS: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_TAG_SCRIPT_SPACE_SRC_EQUALS;
+                        } else if (c == '"' || c == '\'') {
+                            derived().startScriptSrcAttribute(currentState, States::IN_TAG_SCRIPT_SPACE_SRC_EQUALS_QUOTE, c);
+                            currentState = States::IN_TAG_SCRIPT_SPACE_SRC_EQUALS_QUOTE;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_SCRIPT_SPACE_SRC_EQUALS_QUOTE: {
+                        if (c == '"' || c == '\'') {
+                            derived().endScriptSrcAttribute(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_ST: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (c == 'y' || c == 'Y') {
+                            currentState = States::IN_TAG_STY;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_TAG_SPACE;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_STY: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (c == 'l' || c == 'L') {
+                            currentState = States::IN_TAG_STYL;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_TAG_SPACE;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_STYL: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (c == 'e' || c == 'E') {
+                            currentState = States::IN_TAG_STYLE;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_TAG_SPACE;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_STYLE: {
+                        if (c == '>') {
+                            currentState = States::IN_STYLE_START;
+                        } else if (c == '/') {
+                            currentState = States::IN_TAG_STYLE_SLASH;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_TAG_STYLE_SPACE;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_STYLE_SLASH: {
+                        if (c == '>') {
+                            derived().resumeText(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_TAG_STYLE_SLASH;
+                        } else {
+                            currentState = States::IN_TAG_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_STYLE_SPACE: {
+                        if (c == '>') {
+                            currentState = States::IN_STYLE_START;
+                        } else {
+                            currentState = States::IN_TAG_STYLE_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_STYLE_SEARCH: {
+                        if (c == '>') {
+                            currentState = States::IN_STYLE_START;
+                        } else if (c == '"' || c == '\'') {
+                            currentState = States::IN_TAG_STYLE_QUOTE;
+                        } else if (c == '/') {
+                            currentState = States::IN_TAG_STYLE_SLASH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_TAG_STYLE_QUOTE: {
+                        if (c == '"' || c == '\'') {
+                            currentState = States::IN_TAG_STYLE_SEARCH;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_STYLE_START: {
+                        if (c == '<') {
+                            currentState = States::IN_TAG_START;
+                        } else {
+                            derived().startStyle(currentState, States::IN_STYLE, c);
+                            currentState = States::IN_STYLE;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_STYLE: {
+                        if (c == '<') {
+                            currentState = States::IN_STYLE_TAG_START;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_STYLE_TAG_START: {
+                        if (c == '/') {
+                            currentState = States::IN_STYLE_TAG_SLASH;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_STYLE_TAG_START;
+                        } else {
+                            currentState = States::IN_STYLE;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_STYLE_TAG_SLASH: {
+                        if (c == 's' || c == 'S') {
+                            currentState = States::IN_STYLE_TAG_SLASH_S;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_STYLE_TAG_SLASH;
+                        } else {
+                            currentState = States::IN_STYLE;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_STYLE_TAG_SLASH_S: {
+                        if (c == 't' || c == 'T') {
+                            currentState = States::IN_STYLE_TAG_SLASH_ST;
+                        } else {
+                            currentState = States::IN_STYLE;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_STYLE_TAG_SLASH_ST: {
+                        if (c == 'y' || c == 'Y') {
+                            currentState = States::IN_STYLE_TAG_SLASH_STY;
+                        } else {
+                            currentState = States::IN_STYLE;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_STYLE_TAG_SLASH_STY: {
+                        if (c == 'l' || c == 'L') {
+                            currentState = States::IN_STYLE_TAG_SLASH_STYL;
+                        } else {
+                            currentState = States::IN_STYLE;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_STYLE_TAG_SLASH_STYL: {
+                        if (c == 'e' || c == 'E') {
+                            currentState = States::IN_STYLE_TAG_SLASH_STYLE;
+                        } else {
+                            currentState = States::IN_STYLE;
+                        }
+
+                        break;
+                    }
+
+                    case States::IN_STYLE_TAG_SLASH_STYLE: {
+                        if (c == '>') {
+                            derived().endStyle(currentState, States::IN_TEXT_SPACE, c);
+                            currentState = States::IN_TEXT_SPACE;
+                        } else if (std::isspace(c)) {
+                            currentState = States::IN_STYLE_TAG_SLASH_STYLE;
+                        } else {
+                            currentState = States::IN_STYLE;
+                        }
+
+                        break;
+                    }
+
+                    default: {
+                        assert(false);
+                    }
+                }
+            }
+
+            /**
+             * Method you can use to parse the next value using the compile-time transition table in
+             * \ref HtmlScrubber::ParserTable.  The same transition methods are triggered as for \ref parse.
+             *
+             * \param[in,out] c The value to be parsed.  Called transition function can modify the value.
+             */
+            inline void parseTable(char& c) {
+                applyTransition(ParserTable::transition(currentState, c), c);
+            }
+
+            /**
+             * Method you can use to take a transition that has already been looked up.  The transition's hook is
+             * triggered and the state machine moves to the transition's next state.
+             *
+             * \param[in]     transition The transition to be taken from the current state.
+             *
+             * \param[in,out] c          The value that triggered the transition.  Called transition function can
+             *                           modify the value.
+             */
+            inline void applyTransition(const ParserTable::Transition& transition, char& c) {
+                States oldState = currentState;
+                States newState = static_cast<States>(transition.nextState);
+
+                switch (transition.hook) {
+                    case ParserTable::Hook::NONE: {
+                        break;
+                    }
+
+                    case ParserTable::Hook::START_TAG: {
+                        derived().startTag(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::MULTIPLE_WHITE_SPACE: {
+                        derived().multipleWhiteSpace(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::WHITESPACE: {
+                        derived().whitespace(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::RESUME_TEXT: {
+                        derived().resumeText(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::END_TAG: {
+                        derived().endTag(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::START_SRC_ATTRIBUTE: {
+                        derived().startSrcAttribute(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::END_SRC_ATTRIBUTE: {
+                        derived().endSrcAttribute(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::START_HREF_ATTRIBUTE: {
+                        derived().startHrefAttribute(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::END_HREF_ATTRIBUTE: {
+                        derived().endHrefAttribute(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::START_CITE_ATTRIBUTE: {
+                        derived().startCiteAttribute(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::END_CITE_ATTRIBUTE: {
+                        derived().endCiteAttribute(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::START_SCRIPT_SRC_ATTRIBUTE: {
+                        derived().startScriptSrcAttribute(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::END_SCRIPT_SRC_ATTRIBUTE: {
+                        derived().endScriptSrcAttribute(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::START_STYLE: {
+                        derived().startStyle(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::END_STYLE: {
+                        derived().endStyle(oldState, newState, c);
+                        break;
+                    }
+
+                    default: {
+                        assert(false);
+                        break;
+                    }
+                }
+
+                currentState = newState;
+            }
+
+            /**
+             * Method you can use to move the state machine directly to a new state without triggering any transition
+             * methods.  Intended for callers that have already determined the outcome of several transitions at once.
+             *
+             * \param[in] newState The new state.
+             */
+            inline void setState(States newState) {
+                currentState = newState;
+            }
+
+            /**
+             * Method that resets the state machine.
+             */
+            void reset() {
+                currentState = States::IN_TEXT_SPACE;
+            }
+
+            /**
+             * Default method triggered on the following transitions:
+             *
+             * * IN_TEXT_SPACE -> IN_TAG_START c == '<'
+             * * IN_TEXT_MULTIPLE_SPACE -> IN_TAG_START c == '<'
+             * * IN_TEXT -> IN_TAG_START c == '<'
+             *
+             * \param[in] oldState Our current state.
+             *
+             * \param[in] newState The new state.
+             *
+             * \param[in] c        The value that triggered this transition.
+             */
+            inline void startTag(
+                    States /* oldState */,
+                    States /* newState */,
+                    char&  /* c */
+                ) {}
+
+            /**
+             * Default method triggered on the following transitions:
+             *
+             * * IN_TEXT_SPACE -> IN_TEXT_MULTIPLE_SPACE std::isspace(c)
+             *
+             * \param[in] oldState Our current state.
+             *
+             * \param[in] newState The new state.
+             *
+             * \param[in] c        The value that triggered this transition.
+             */
+            inline void multipleWhiteSpace(
+                    States /* oldState */,
+                    States /* newState */,
+                    char&  /* c */
+                ) {}
+
+            /**
+             * Default method triggered on the following transitions:
+             *
+             * * IN_TEXT_SPACE -> IN_TEXT c != '<' && !std::isspace(c)
+             * * IN_TEXT_MULTIPLE_SPACE -> IN_TEXT c != '<' && !std::isspace(c)
+             * * IN_TAG_SPACE_S -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_SPACE_SR -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_SPACE_SRC -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_SPACE_SRC_EQUALS -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_SPACE_H -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_SPACE_HR -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_SPACE_HRE -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_SPACE_HREF -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_SPACE_HREF_EQUALS -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_SPACE_C -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_SPACE_CI -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_SPACE_CIT -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_SPACE_CITE -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_SPACE_CITE_EQUALS -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_S -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_SC -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_SCR -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_SCRI -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_SCRIP -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_SCRIPT -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_SCRIPT_SPACE -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_SCRIPT_SPACE_S -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_SCRIPT_SPACE_SR -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_SCRIPT_SPACE_SRC -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_SCRIPT_SPACE_SRC_EQUALS -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_ST -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_STY -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_STYL -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_STYLE_SLASH -> IN_TEXT_SPACE c == '>'
+             *
+             * \param[in] oldState Our current state.
+             *
+             * \param[in] newState The new state.
+             *
+             * \param[in] c        The value that triggered this transition.
+             */
+            inline void resumeText(
+                    States /* oldState */,
+                    States /* newState */,
+                    char&  /* c */
+                ) {}
+
+            /**
+             * Default method triggered on the following transitions:
+             *
+             * * IN_TEXT -> IN_TEXT_SPACE std::isspace(c)
+             *
+             * \param[in] oldState Our current state.
+             *
+             * \param[in] newState The new state.
+             *
+             * \param[in] c        The value that triggered this transition.
+             */
+            inline void whitespace(
+                    States /* oldState */,
+                    States /* newState */,
+                    char&  /* c */
+                ) {}
+
+            /**
+             * Default method triggered on the following transitions:
+             *
+             * * IN_TAG_SEARCH -> IN_TEXT_SPACE c == '>'
+             * * IN_TAG_SPACE -> IN_TEXT_SPACE c == '>'
+             *
+             * \param[in] oldState Our current state.
+             *
+             * \param[in] newState The new state.
+             *
+             * \param[in] c        The value that triggered this transition.
+             */
+            inline void endTag(
+                    States /* oldState */,
+                    States /* newState */,
+                    char&  /* c */
+                ) {}
+
+            /**
+             * Default method triggered on the following transitions:
+             *
+             * * IN_TAG_SPACE_SRC_EQUALS -> IN_TAG_SPACE_SRC_EQUALS_QUOTE c == '"' || c == '\''
+             *
+             * \param[in] oldState Our current state.
+             *
+             * \param[in] newState The new state.
+             *
+             * \param[in] c        The value that triggered this transition.
+             */
+            inline void startSrcAttribute(
+                    States /* oldState */,
+                    States /* newState */,
+                    char&  /* c */
+                ) {}
+
+            /**
+             * Default method triggered on the following transitions:
+             *
+             * * IN_TAG_SPACE_SRC_EQUALS_QUOTE -> IN_TAG_SEARCH c == '"' || c == '\''
+             * * IN_TAG_SPACE_SRC_EQUALS_QUOTE -> IN_TAG_SPACE_SRC_EQUALS_QUOTE_QM c == '?'
+             *
+             * \param[in] oldState Our current state.
+             *
+             * \param[in] newState The new state.
+             *
+             * \param[in] c        The value that triggered this transition.
+             */
+            inline void endSrcAttribute(
+                    States /* oldState */,
+                    States /* newState */,
+                    char&  /* c */
+                ) {}
+
+            /**
+             * Default method triggered on the following transitions:
+             *
+             * * IN_TAG_SPACE_HREF_EQUALS -> IN_TAG_SPACE_HREF_EQUALS_QUOTE c == '"' || c == '\''
+             *
+             * \param[in] oldState Our current state.
+             *
+             * \param[in] newState The new state.
+             *
+             * \param[in] c        The value that triggered this transition.
+             */
+            inline void startHrefAttribute(
+                    States /* oldState */,
+                    States /* newState */,
+                    char&  /* c */
+                ) {}
+
+            /**
+             * Default method triggered on the following transitions:
+             *
+             * * IN_TAG_SPACE_HREF_EQUALS_QUOTE -> IN_TAG_SEARCH c == '"' || c == '\''
+             *
+             * \param[in] oldState Our current state.
+             *
+             * \param[in] newState The new state.
+             *
+             * \param[in] c        The value that triggered this transition.
+             */
+            inline void endHrefAttribute(
+                    States /* oldState */,
+                    States /* newState */,
+                    char&  /* c */
+                ) {}
+
+            /**
+             * Default method triggered on the following transitions:
+             *
+             * * IN_TAG_SPACE_CITE_EQUALS -> IN_TAG_SPACE_CITE_EQUALS_QUOTE c == '"' || c == '\''
+             *
+             * \param[in] oldState Our current state.
+             *
+             * \param[in] newState The new state.
+             *
+             * \param[in] c        The value that triggered this transition.
+             */
+            inline void startCiteAttribute(
+                    States /* oldState */,
+                    States /* newState */,
+                    char&  /* c */
+                ) {}
+
+            /**
+             * Default method triggered on the following transitions:
+             *
+             * * IN_TAG_SPACE_CITE_EQUALS_QUOTE -> IN_TAG_SEARCH c == '"' || c == '\''
+             *
+             * \param[in] oldState Our current state.
+             *
+             * \param[in] newState The new state.
+             *
+             * \param[in] c        The value that triggered this transition.
+             */
+            inline void endCiteAttribute(
+                    States /* oldState */,
+                    States /* newState */,
+                    char&  /* c */
+                ) {}
+
+            /**
+             * Default method triggered on the following transitions:
+             *
+             * * IN_TAG_SCRIPT_SPACE_SRC_EQUALS -> IN_TAG_SCRIPT_SPACE_SRC_EQUALS_QUOTE c == '"' || c == '\''
+             *
+             * \param[in] oldState Our current state.
+             *
+             * \param[in] newState The new state.
+             *
+             * \param[in] c        The value that triggered this transition.
+             */
+            inline void startScriptSrcAttribute(
+                    States /* oldState */,
+                    States /* newState */,
+                    char&  /* c */
+                ) {}
+
+            /**
+             * Default method triggered on the following transitions:
+             *
+             * * IN_TAG_SCRIPT_SPACE_SRC_EQUALS_QUOTE -> IN_TEXT_SPACE c == '"' || c == '\''
+             *
+             * \param[in] oldState Our current state.
+             *
+             * \param[in] newState The new state.
+             *
+             * \param[in] c        The value that triggered this transition.
+             */
+            inline void endScriptSrcAttribute(
+                    States /* oldState */,
+                    States /* newState */,
+                    char&  /* c */
+                ) {}
+
+            /**
+             * Default method triggered on the following transitions:
+             *
+             * * IN_STYLE_START -> IN_STYLE
+             *
+             * \param[in] oldState Our current state.
+             *
+             * \param[in] newState The new state.
+             *
+             * \param[in] c        The value that triggered this transition.
+             */
+            inline void startStyle(
+                    States /* oldState */,
+                    States /* newState */,
+                    char&  /* c */
+                ) {}
+
+            /**
+             * Default method triggered on the following transitions:
+             *
+             * * IN_STYLE_TAG_SLASH_STYLE -> IN_TEXT_SPACE c == '>'
+             *
+             * \param[in] oldState Our current state.
+             *
+             * \param[in] newState The new state.
+             *
+             * \param[in] c        The value that triggered this transition.
+             */
+            inline void endStyle(
+                    States /* oldState */,
+                    States /* newState */,
+                    char&  /* c */
+                ) {}
+
+        private:
+            /**
+             * Method that returns this instance as the derived class.
+             *
+             * \return Returns a reference to the derived class instance.
+             */
+            inline Derived& derived() {
+                return *static_cast<Derived*>(this);
+            }
+    };
+}
+
+#endif
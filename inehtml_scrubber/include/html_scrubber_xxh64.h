@@ -0,0 +1,122 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides a streaming implementation of the XXH64 hash.
+***********************************************************************************************************************/
+
+/* .. sphinx-project inehtmlscrubber */
+
+#ifndef HTML_SCRUBBER_XXH64_H
+#define HTML_SCRUBBER_XXH64_H
+
+#include <cstdint>
+
+namespace HtmlScrubber {
+    /**
+     * Class that calculates the XXH64 hash, as specified by Yann Collet's xxHash reference implementation, from data
+     * supplied in pieces.  XXH64 is not a cryptographic hash.  It processes data in 32 byte stripes using four
+     * independent accumulators and runs close to memory bandwidth.
+     */
+    class Xxh64 {
+        public:
+            /**
+             * The number of bytes consumed by each round of the hash.
+             */
+            static constexpr unsigned long stripeLength = 32;
+
+            /**
+             * Constructor
+             *
+             * \param[in] seed The seed for the hash.
+             */
+            Xxh64(std::uint64_t seed = 0);
+
+            ~Xxh64();
+
+            /**
+             * Method you can use to restart the hash.
+             *
+             * \param[in] seed The seed for the hash.
+             */
+            void reset(std::uint64_t seed = 0);
+
+            /**
+             * Method you can use to add data to the hash.
+             *
+             * \param[in] data   Pointer to the data to be hashed.
+             *
+             * \param[in] length The length of the data, in bytes.
+             */
+            void addData(const char* data, unsigned long length);
+
+            /**
+             * Method you can use to obtain the hash of the data added so far.  Further data can be added afterwards.
+             *
+             * \return Returns the hash.
+             */
+            std::uint64_t result() const;
+
+            /**
+             * Method that hashes a complete buffer.
+             *
+             * \param[in] data   Pointer to the data to be hashed.
+             *
+             * \param[in] length The length of the data, in bytes.
+             *
+             * \param[in] seed   The seed for the hash.
+             *
+             * \return Returns the hash.
+             */
+            static std::uint64_t hash(const char* data, unsigned long length, std::uint64_t seed = 0);
+
+        private:
+            /**
+             * Method that consumes whole stripes.
+             *
+             * \param[in] data          Pointer to the stripes.
+             *
+             * \param[in] numberStripes The number of stripes to consume.
+             */
+            void consume(const char* data, unsigned long numberStripes);
+
+            /**
+             * The accumulators.
+             */
+            std::uint64_t accumulators[4];
+
+            /**
+             * The seed for the hash.
+             */
+            std::uint64_t currentSeed;
+
+            /**
+             * The total number of bytes added.
+             */
+            std::uint64_t totalLength;
+
+            /**
+             * The number of bytes held in the partial stripe buffer.
+             */
+            unsigned long bufferedLength;
+
+            /**
+             * Bytes that do not yet form a complete stripe.
+             */
+            char buffer[stripeLength];
+    };
+};
+#endif
@@ -21,7 +21,7 @@ TEMPLATE = lib
 #
 
 QT += core
-CONFIG += static c++14
+CONFIG += static c++14 thread
 
 win32 {
     # Windows generates a warning about potential overflow during operations on integer values.  While the warning may
@@ -31,23 +31,68 @@ win32 {
     QMAKE_CXXFLAGS_WARN_ON += -wd4307
 }
 
+vbmi {
+    # Builds with AVX-512 VBMI so the block parallel back-end, HtmlScrubber::Engine::Backend::PARALLEL, can build its
+    # state maps with VPERMB.  Without this option that back-end always falls back to the serial transition table.
+    # The resulting library only runs on processors supporting AVX-512 VBMI.  MSVC has no option enabling VBMI so the
+    # option only applies to GCC and Clang.
+
+    gcc|clang:QMAKE_CXXFLAGS += -mavx512bw -mavx512vbmi
+}
+
 ########################################################################################################################
 # Public includes
 #
 
 INCLUDEPATH += include
 HEADERS = include/html_scrubber_parser.h \
+          include/html_scrubber_parser_table.h \
+          include/html_scrubber_static_parser.h \
+          include/html_scrubber_sink.h \
+          include/html_scrubber_span_sink.h \
+          include/html_scrubber_fan_out_sink.h \
+          include/html_scrubber_byte_array_sink.h \
+          include/html_scrubber_cryptographic_hash_sink.h \
           include/html_scrubber_engine.h \
+          include/html_scrubber_digest.h \
           include/html_scrubber_scrubber.h \
           include/html_scrubber_hasher.h \
+          include/html_scrubber_hashing_device.h \
+          include/html_scrubber_xxh64.h \
+          include/html_scrubber_fast_hasher.h \
+          include/html_scrubber_fast_hash_sink.h \
+          include/html_scrubber_chunk_hash_sink.h \
+          include/html_scrubber_sim_hash_sink.h \
+          source/html_scrubber_engine_step.h \
+          source/html_scrubber_keyword_matcher.h \
+          source/html_scrubber_mapped_file.h \
+          source/html_scrubber_scanner.h \
+          source/html_scrubber_state_map.h \
+          source/html_scrubber_utf8.h \
 
 ########################################################################################################################
 # Source files
 #
 
-SOURCES = source/html_scrubber_engine.cpp \
+SOURCES = source/html_scrubber_parser_table.cpp \
+          source/html_scrubber_state_map.cpp \
+          source/html_scrubber_utf8.cpp \
+          source/html_scrubber_sink.cpp \
+          source/html_scrubber_span_sink.cpp \
+          source/html_scrubber_fan_out_sink.cpp \
+          source/html_scrubber_byte_array_sink.cpp \
+          source/html_scrubber_cryptographic_hash_sink.cpp \
+          source/html_scrubber_engine.cpp \
           source/html_scrubber_scrubber.cpp \
+          source/html_scrubber_digest.cpp \
+          source/html_scrubber_mapped_file.cpp \
           source/html_scrubber_hasher.cpp \
+          source/html_scrubber_hashing_device.cpp \
+          source/html_scrubber_xxh64.cpp \
+          source/html_scrubber_fast_hasher.cpp \
+          source/html_scrubber_fast_hash_sink.cpp \
+          source/html_scrubber_chunk_hash_sink.cpp \
+          source/html_scrubber_sim_hash_sink.cpp \
 
 ########################################################################################################################
 # Locate build intermediate and output products
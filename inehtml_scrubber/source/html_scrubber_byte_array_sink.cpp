@@ -0,0 +1,78 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the QByteArray sink.
+***********************************************************************************************************************/
+
+#include <QtGlobal>
+#include <QByteArray>
+
+#include "html_scrubber_sink.h"
+#include "html_scrubber_scrubber.h"
+#include "html_scrubber_byte_array_sink.h"
+
+namespace HtmlScrubber {
+    ByteArraySink::ByteArraySink():dataTruncated(false) {}
+
+
+    ByteArraySink::~ByteArraySink() {}
+
+
+    void ByteArraySink::update(const char* data, unsigned long length) {
+        unsigned long currentLength = static_cast<unsigned long>(currentData.size());
+
+        if (!dataTruncated && length <= Scrubber::maximumOutputSize - currentLength) {
+            currentData.append(data, static_cast<int>(length));
+        } else {
+            dataTruncated = true;
+        }
+    }
+
+
+    void ByteArraySink::clear() {
+        /*
+         * Qt 5 releases the buffer when an array is resized to zero unless capacity has been reserved.
+         */
+        if (currentData.capacity() > 0) {
+            currentData.reserve(currentData.capacity());
+        }
+
+        currentData.truncate(0);
+        dataTruncated = false;
+    }
+
+
+    bool ByteArraySink::reserve(unsigned long length) {
+        bool success = length <= Scrubber::maximumOutputSize;
+
+        if (success) {
+            currentData.reserve(static_cast<int>(length));
+        }
+
+        return success;
+    }
+
+
+    bool ByteArraySink::truncated() const {
+        return dataTruncated;
+    }
+
+
+    const QByteArray& ByteArraySink::data() const {
+        return currentData;
+    }
+}
@@ -0,0 +1,192 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the content-defined chunk hashing sink.
+***********************************************************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <cassert>
+#include <vector>
+
+#include "html_scrubber_sink.h"
+#include "html_scrubber_xxh64.h"
+#include "html_scrubber_chunk_hash_sink.h"
+
+namespace {
+    /*
+     * The number of bits by which the masks differ from those implied by the average chunk length.
+     */
+    const unsigned normalizationLevel = 2;
+
+    /*
+     * Table holding a pseudo-random value for each byte value, used by the Gear rolling hash.
+     */
+    struct GearTable {
+        GearTable() {
+            std::uint64_t state = 0x2545F4914F6CDD1DULL;
+
+            for (unsigned byte=0 ; byte<256 ; ++byte) {
+                state += 0x9E3779B97F4A7C15ULL;
+
+                std::uint64_t value = state;
+                value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+
+                entries[byte] = value ^ (value >> 31);
+            }
+        }
+
+        std::uint64_t entries[256];
+    };
+
+    /*
+     * Function that returns the shared Gear table.
+     */
+    const GearTable& gearTable() {
+        static const GearTable table;
+        return table;
+    }
+
+    /*
+     * Function that builds a mask selecting the most significant bits of the rolling hash.  The high bits depend on
+     * the most recent 64 bytes while the low bits depend only on the last few.
+     */
+    std::uint64_t highMask(unsigned numberBits) {
+        return ~std::uint64_t(0) << (64 - numberBits);
+    }
+}
+
+namespace HtmlScrubber {
+    ChunkHashSink::ChunkHashSink(
+            unsigned long minimumLength,
+            unsigned long averageLength,
+            unsigned long maximumLength
+        ):currentMinimumLength(
+            minimumLength
+        ), currentAverageLength(
+            averageLength
+        ), currentMaximumLength(
+            maximumLength
+        ), fingerprint(
+            0
+        ), chunkOffset(
+            0
+        ), chunkLength(
+            0
+        ) {
+        assert(minimumLength < averageLength && averageLength < maximumLength);
+        assert((averageLength & (averageLength - 1)) == 0 && averageLength >= 64 && averageLength <= (1UL << 28));
+
+        unsigned averageBits = 0;
+        while ((1UL << averageBits) < averageLength) {
+            ++averageBits;
+        }
+
+        smallMask = highMask(averageBits + normalizationLevel);
+        largeMask = highMask(averageBits - normalizationLevel);
+    }
+
+
+    ChunkHashSink::~ChunkHashSink() {}
+
+
+    void ChunkHashSink::update(const char* data, unsigned long length) {
+        const std::uint64_t* gear = gearTable().entries;
+
+        while (length > 0) {
+            unsigned long consumed;
+            bool          boundary = false;
+
+            if (chunkLength < currentMinimumLength) {
+                consumed = std::min(length, currentMinimumLength - chunkLength);
+            } else {
+                unsigned long position = chunkLength;
+                unsigned long limit    = std::min(chunkLength + length, currentMaximumLength);
+                std::uint64_t hash     = fingerprint;
+
+                while (!boundary && position < limit) {
+                    hash = (hash << 1) + gear[static_cast<std::uint8_t>(data[position - chunkLength])];
+                    ++position;
+
+                    std::uint64_t mask = position < currentAverageLength ? smallMask : largeMask;
+                    boundary = (hash & mask) == 0 || position == currentMaximumLength;
+                }
+
+                fingerprint = hash;
+                consumed    = position - chunkLength;
+            }
+
+            chunkHash.addData(data, consumed);
+            chunkLength += consumed;
+
+            if (boundary) {
+                closeChunk();
+            }
+
+            data   += consumed;
+            length -= consumed;
+        }
+    }
+
+
+    void ChunkHashSink::clear() {
+        currentChunks.clear();
+        chunkHash.reset();
+
+        fingerprint = 0;
+        chunkOffset = 0;
+        chunkLength = 0;
+    }
+
+
+    void ChunkHashSink::finish() {
+        if (chunkLength > 0) {
+            closeChunk();
+        }
+    }
+
+
+    const std::vector<ChunkHashSink::Chunk>& ChunkHashSink::chunks() const {
+        return currentChunks;
+    }
+
+
+    unsigned long ChunkHashSink::minimumLength() const {
+        return currentMinimumLength;
+    }
+
+
+    unsigned long ChunkHashSink::averageLength() const {
+        return currentAverageLength;
+    }
+
+
+    unsigned long ChunkHashSink::maximumLength() const {
+        return currentMaximumLength;
+    }
+
+
+    void ChunkHashSink::closeChunk() {
+        currentChunks.push_back(Chunk { chunkOffset, chunkLength, chunkHash.result() });
+        chunkHash.reset();
+
+        chunkOffset += chunkLength;
+        chunkLength  = 0;
+        fingerprint  = 0;
+    }
+}
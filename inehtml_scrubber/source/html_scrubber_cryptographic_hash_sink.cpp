@@ -0,0 +1,41 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the cryptographic hash sink.
+***********************************************************************************************************************/
+
+#include <QtGlobal>
+#include <QCryptographicHash>
+
+#include "html_scrubber_sink.h"
+#include "html_scrubber_cryptographic_hash_sink.h"
+
+namespace HtmlScrubber {
+    CryptographicHashSink::CryptographicHashSink(
+            CryptographicHashSink::Algorithm hashAlgorithm
+        ):QCryptographicHash(
+            hashAlgorithm
+        ) {}
+
+
+    CryptographicHashSink::~CryptographicHashSink() {}
+
+
+    void CryptographicHashSink::update(const char* data, unsigned long length) {
+        QCryptographicHash::addData(data, length);
+    }
+}
@@ -0,0 +1,61 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the digest value type.
+***********************************************************************************************************************/
+
+#include <cstring>
+
+#include "html_scrubber_digest.h"
+
+namespace HtmlScrubber {
+    Digest::Digest():currentLength(0) {}
+
+
+    Digest::Digest(const char* data, unsigned long length) {
+        currentLength = length < maximumLength ? length : maximumLength;
+        std::memcpy(bytes, data, currentLength);
+    }
+
+
+    Digest::~Digest() {}
+
+
+    const char* Digest::data() const {
+        return bytes;
+    }
+
+
+    unsigned long Digest::length() const {
+        return currentLength;
+    }
+
+
+    bool Digest::isEmpty() const {
+        return currentLength == 0;
+    }
+
+
+    bool Digest::operator==(const Digest& other) const {
+        return currentLength == other.currentLength && std::memcmp(bytes, other.bytes, currentLength) == 0;
+    }
+
+
+    bool Digest::operator!=(const Digest& other) const {
+        return !operator==(other);
+    }
+}
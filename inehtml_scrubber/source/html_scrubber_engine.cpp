@@ -18,62 +18,620 @@
 * This file implements a trivial HTML scrubber function.
 ***********************************************************************************************************************/
 
-#include <QtGlobal>
-#include <QByteArray>
-#include <QString>
-
+#include <algorithm>
+#include <atomic>
+#include <cassert>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 #include "html_scrubber_parser.h"
+#include "html_scrubber_static_parser.h"
+#include "html_scrubber_span_sink.h"
+#include "html_scrubber_state_map.h"
+#include "html_scrubber_utf8.h"
 #include "html_scrubber_engine.h"
+#include "html_scrubber_engine_step.h"
 
 namespace HtmlScrubber {
-    Engine::Engine(const QByteArray& rawData):inputData(rawData) {}
+    namespace {
+        /*
+         * The padding bytes, used when the padding is simulated.
+         */
+        const char padding[Engine::paddingLength] = { '\0', '\0', '\0', '\0' };
+
+        /*
+         * Sink that writes scrubbed data to a fixed size buffer.  The data may overlap the buffer, which allows output
+         * to be compacted over input that has already been scanned.
+         */
+        class BufferSink:public Sink {
+            public:
+                BufferSink(
+                        char*         destination,
+                        unsigned long capacity
+                    ):outputBuffer(
+                        destination
+                    ), outputCapacity(
+                        capacity
+                    ), currentLength(
+                        0
+                    ) {}
+
+                void update(const char* data, unsigned long length) override {
+                    if (currentLength + length <= outputCapacity) {
+                        std::memmove(outputBuffer + currentLength, data, length);
+                    }
+
+                    currentLength += length;
+                }
+
+                unsigned long length() const {
+                    return currentLength;
+                }
+
+            private:
+                char*         outputBuffer;
+                unsigned long outputCapacity;
+                unsigned long currentLength;
+        };
+
+        /*
+         * Structure holding every byte value.  Used to report substituted bytes without modifying read-only input.
+         */
+        struct ByteValues {
+            ByteValues() {
+                for (unsigned value=0 ; value<256 ; ++value) {
+                    values[value] = static_cast<char>(value);
+                }
+            }
+
+            char values[256];
+        };
+
+        const ByteValues byteValues;
+
+        /*
+         * Function that determines the default number of worker threads for the block parallel back-end.  The
+         * calling thread scrubs a chunk too, so one hardware thread is left for it.
+         */
+        unsigned defaultWorkerThreadLimit() {
+            unsigned hardwareThreads = std::thread::hardware_concurrency();
+            return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+        }
+
+        /*
+         * The number of worker threads the block parallel back-end may use, shared by all engines.
+         */
+        std::atomic<unsigned> workerThreadLimit(defaultWorkerThreadLimit());
+
+        /*
+         * The number of worker threads currently reserved by block parallel scrubs.
+         */
+        std::atomic<unsigned> workerThreadsInUse(0);
+
+        /*
+         * Class that reserves worker threads from the shared limit and returns them when destroyed.  Fewer threads
+         * than requested, possibly none, are reserved when other scrubs are using them.
+         */
+        class WorkerThreads {
+            public:
+                explicit WorkerThreads(unsigned requested) {
+                    unsigned inUse = workerThreadsInUse.load();
+
+                    do {
+                        unsigned limit = workerThreadLimit.load();
+                        reserved = inUse < limit ? std::min(requested, limit - inUse) : 0;
+                    } while (reserved > 0 && !workerThreadsInUse.compare_exchange_weak(inUse, inUse + reserved));
+                }
+
+                ~WorkerThreads() {
+                    workerThreadsInUse -= reserved;
+                }
+
+                unsigned count() const {
+                    return reserved;
+                }
+
+            private:
+                unsigned reserved;
+        };
+
+        /*
+         * Function that runs work for chunks first through last - 1.  The first chunk runs on the calling thread and
+         * every other chunk on its own thread.  If a thread can not be started, no further threads are started and
+         * the remaining chunks run on the calling thread, after the first.  Every thread is joined before returning.
+         */
+        template<typename Work> void runChunks(unsigned first, unsigned last, const Work& work) {
+            std::vector<std::thread> threads;
+            unsigned                 serialChunk = last;
+
+            threads.reserve(last - first - 1);
+
+            try {
+                for (unsigned chunk=first + 1 ; chunk<last ; ++chunk) {
+                    threads.emplace_back(work, chunk);
+                }
+            } catch (const std::system_error&) {
+                serialChunk = first + 1 + static_cast<unsigned>(threads.size());
+            }
+
+            work(first);
+
+            for (unsigned chunk=serialChunk ; chunk<last ; ++chunk) {
+                work(chunk);
+            }
+
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+        }
+    }
+
+    Engine::Engine(const char* rawData, unsigned long length, Engine::InputMode inputMode) {
+        currentBackend    = Backend::SWITCH;
+        currentUtf8Policy = Utf8Policy::PASS_THROUGH;
+        currentInputMode  = inputMode;
+        streamValid           = true;
+        pendingSkip           = 0;
+        pendingSequenceLength = 0;
+        stagingEnabled        = true;
+        stagingLength         = 0;
+        currentSink           = nullptr;
+
+        inputData             = rawData;
+        inputDataLength       = length;
+        inputCopied           = false;
+
+        if (inputMode == InputMode::COPY) {
+            copyInput();
+        }
+    }
 
 
     Engine::~Engine() {}
 
 
-    void Engine::scrub() {
-        inputData.append('\0');
-        inputData.append('\0');
-        inputData.append('\0');
-        inputData.append('\0');
+    bool Engine::scrub() {
+        bool success;
 
-        char*         basePointer     = inputData.data();
-        unsigned long inputBase       = 0;
-        unsigned long inputIndex      = 0;
-        unsigned long inputLength     = static_cast<unsigned long>(inputData.size());
-        unsigned long outputLength    = 0;
-        CaptureMode   lastCaptureMode = CaptureMode::IN_TEXT;
-        captureMode  = CaptureMode::IN_TEXT;
+        switch (currentBackend) {
+            case Backend::SWITCH: {
+                success = scrubUsing<Backend::SWITCH>();
+                break;
+            }
 
+            case Backend::TABLE: {
+                success = scrubUsing<Backend::TABLE>();
+                break;
+            }
+
+            case Backend::PARALLEL: {
+                success = scrubUsing<Backend::PARALLEL>();
+                break;
+            }
+
+            default: {
+                assert(false);
+                success = false;
+                break;
+            }
+        }
+
+        return success;
+    }
+
+
+    bool Engine::scrub(
+            const char*        rawData,
+            unsigned long      length,
+            Sink&              sink,
+            Engine::Backend    scrubBackend,
+            Engine::Utf8Policy scrubPolicy
+        ) {
+        Engine engine(rawData, length, InputMode::READ_ONLY);
+        engine.setSink(&sink);
+        engine.setBackend(scrubBackend);
+        engine.setUtf8Policy(scrubPolicy);
+
+        return engine.scrub();
+    }
+
+
+    bool Engine::scrubInPlace(
+            char*              data,
+            unsigned long      length,
+            unsigned long      capacity,
+            unsigned long&     outputLength,
+            Engine::Backend    scrubBackend,
+            Engine::Utf8Policy scrubPolicy
+        ) {
+        bool          success        = false;
+        unsigned long replacedLength = length;
+
+        if (scrubPolicy == Utf8Policy::REPLACE) {
+            replacedLength = Utf8::replacedLength(data, length);
+        }
+
+        if (replacedLength + paddingLength <= capacity) {
+            unsigned long offset = replacedLength - length;
+            BufferSink    sink(data, capacity);
+
+            if (offset > 0) {
+                std::memmove(data + offset, data, length);
+            }
+
+            if (scrub(data + offset, length, sink, scrubBackend, scrubPolicy)) {
+                assert(sink.length() <= replacedLength + paddingLength);
+
+                outputLength = sink.length();
+                success      = true;
+            }
+        } else if (capacity >= length + paddingLength) {
+            std::vector<char> output(replacedLength + paddingLength);
+            BufferSink        sink(output.data(), static_cast<unsigned long>(output.size()));
+
+            if (scrub(data, length, sink, scrubBackend, scrubPolicy) && sink.length() <= capacity) {
+                std::memcpy(data, output.data(), sink.length());
 
+                outputLength = sink.length();
+                success      = true;
+            }
+        }
+
+        return success;
+    }
+
+
+    void Engine::begin() {
         reset();
 
-        while (inputIndex < inputLength) {
-            char& c = basePointer[inputIndex];
+        captureMode           = CaptureMode::IN_TEXT;
+        streamValid           = true;
+        pendingSkip           = 0;
+        pendingSequenceLength = 0;
+        stagingLength         = 0;
+    }
+
+
+    bool Engine::feed(const char* data, unsigned long length) {
+        unsigned long inputBase    = 0;
+        unsigned long inputIndex   = 0;
+        unsigned long outputLength = 0;
+
+        if (!streamValid) {
+            return false;
+        }
+
+        if (pendingSkip > 0) {
+            inputIndex   = std::min(pendingSkip, length);
+            pendingSkip -= inputIndex;
+
+            if (captureMode != CaptureMode::IGNORE) {
+                outputLength = inputIndex;
+            }
+        } else if (pendingSequenceLength > 0) {
+            unsigned long copied = std::min(
+                static_cast<unsigned long>(sizeof(pendingSequence)) - pendingSequenceLength,
+                length
+            );
+            std::memcpy(pendingSequence + pendingSequenceLength, data, copied);
+
+            bool          validSequence;
+            unsigned long available = pendingSequenceLength + copied;
+            unsigned long sequence  = Utf8::decode(pendingSequence, available, validSequence);
+
+            if (!validSequence && sequence == available && sequence < Utf8::sequenceLength(pendingSequence[0])) {
+                pendingSequenceLength = available;
+                return true;
+            }
+
+            if (!validSequence && currentUtf8Policy == Utf8Policy::REJECT) {
+                streamValid = false;
+                return false;
+            }
+
+            if (captureMode != CaptureMode::IGNORE) {
+                if (validSequence) {
+                    writeOutput(pendingSequence, sequence);
+                } else {
+                    writeOutput(Utf8::replacementCharacter, sizeof(Utf8::replacementCharacter));
+                }
+            }
+
+            inputIndex            = sequence - pendingSequenceLength;
+            inputBase             = inputIndex;
+            pendingSequenceLength = 0;
+        }
+
+        while (inputIndex < length) {
+            char c = data[inputIndex];
 
             if ((c & 0x80) == 0x00) {
-                lastCaptureMode = captureMode;
+                if (currentBackend == Backend::SWITCH) {
+                    scrubStep<Backend::SWITCH>(data, nullptr, length, inputBase, inputIndex, outputLength);
+                } else {
+                    scrubStep<Backend::TABLE>(data, nullptr, length, inputBase, inputIndex, outputLength);
+                }
+            } else if (currentUtf8Policy == Utf8Policy::PASS_THROUGH) {
+                unsigned long sequence;
+
+                if ((c & 0xE0) == 0xC0) {
+                    sequence = 2;
+                } else if ((c & 0xF0) == 0xE0) {
+                    sequence = 3;
+                } else if ((c & 0xF8) == 0xF0) {
+                    sequence = 4;
+                } else {
+                    sequence = 1;
+                }
 
-                parse(c);
+                if (sequence > length - inputIndex) {
+                    pendingSkip = sequence - (length - inputIndex);
+                    sequence    = length - inputIndex;
+                }
 
-                if (captureMode == CaptureMode::IGNORE) {
-                    if (lastCaptureMode != CaptureMode::IGNORE) {
-                        update(basePointer + inputBase, outputLength);
+                if (captureMode != CaptureMode::IGNORE) {
+                    outputLength += sequence;
+                }
+
+                inputIndex += sequence;
+            } else {
+                bool          validSequence;
+                unsigned long available = length - inputIndex;
+                unsigned long sequence  = Utf8::decode(data + inputIndex, available, validSequence);
+
+                if (!validSequence && sequence == available && sequence < Utf8::sequenceLength(c)) {
+                    std::memcpy(pendingSequence, data + inputIndex, available);
+                    pendingSequenceLength = available;
+
+                    if (captureMode != CaptureMode::IGNORE) {
+                        writeOutput(data + inputBase, outputLength);
                         outputLength = 0;
                     }
+
+                    inputIndex = length;
+                    inputBase  = length;
+                } else if (validSequence) {
+                    if (captureMode != CaptureMode::IGNORE) {
+                        outputLength += sequence;
+                    }
+
+                    inputIndex += sequence;
+                } else if (currentUtf8Policy == Utf8Policy::REJECT) {
+                    streamValid = false;
+                    return false;
                 } else {
-                    ++outputLength;
+                    if (captureMode != CaptureMode::IGNORE) {
+                        writeOutput(data + inputBase, outputLength);
+                        writeOutput(Utf8::replacementCharacter, sizeof(Utf8::replacementCharacter));
 
-                    if (lastCaptureMode == CaptureMode::IGNORE) {
-                        inputBase = inputIndex;
+                        outputLength = 0;
+                        inputBase    = inputIndex + sequence;
                     }
+
+                    inputIndex += sequence;
                 }
+            }
+        }
 
-                ++inputIndex;
+        if (captureMode != CaptureMode::IGNORE) {
+            writeOutput(data + inputBase, outputLength);
+        }
+
+        return true;
+    }
+
+
+    bool Engine::finish() {
+        if (streamValid && pendingSequenceLength > 0) {
+            if (currentUtf8Policy == Utf8Policy::REJECT) {
+                streamValid = false;
+            } else if (captureMode != CaptureMode::IGNORE) {
+                writeOutput(Utf8::replacementCharacter, sizeof(Utf8::replacementCharacter));
+            }
+
+            pendingSequenceLength = 0;
+        }
+
+        if (!streamValid) {
+            stagingLength = 0;
+            return false;
+        }
+
+        finishOutput(padding, 0, pendingSkip, pendingSkip, true);
+        pendingSkip = 0;
+
+        return true;
+    }
+
+
+    void Engine::setInput(const char* rawData, unsigned long length, Engine::InputMode inputMode) {
+        currentInputMode = inputMode;
+        inputData        = rawData;
+        inputDataLength  = length;
+        inputCopied      = false;
+
+        if (inputMode == InputMode::COPY) {
+            copyInput();
+        }
+    }
+
+
+    void Engine::setSink(Sink* newSink) {
+        currentSink    = newSink;
+        stagingEnabled = newSink == nullptr || !newSink->retainsData();
+    }
+
+
+    Sink* Engine::sink() const {
+        return currentSink;
+    }
+
+
+    void Engine::setBackend(Engine::Backend newBackend) {
+        currentBackend = newBackend;
+    }
+
+
+    Engine::Backend Engine::backend() const {
+        return currentBackend;
+    }
+
+
+    void Engine::setParallelThreadLimit(unsigned newLimit) {
+        workerThreadLimit = newLimit;
+    }
+
+
+    unsigned Engine::parallelThreadLimit() {
+        return workerThreadLimit.load();
+    }
+
+
+    void Engine::setUtf8Policy(Engine::Utf8Policy newUtf8Policy) {
+        currentUtf8Policy = newUtf8Policy;
+    }
+
+
+    Engine::Utf8Policy Engine::utf8Policy() const {
+        return currentUtf8Policy;
+    }
+
+
+    Engine::InputMode Engine::inputMode() const {
+        return currentInputMode;
+    }
+
+
+    std::vector<Engine::Run> Engine::runs() {
+        std::vector<Run> result;
+        bool             success;
+
+        switch (currentBackend) {
+            case Backend::SWITCH: {
+                success = runsUsing<Backend::SWITCH>(result);
+                break;
+            }
+
+            case Backend::TABLE: {
+                success = runsUsing<Backend::TABLE>(result);
+                break;
+            }
+
+            case Backend::PARALLEL: {
+                success = runsUsing<Backend::PARALLEL>(result);
+                break;
+            }
+
+            default: {
+                assert(false);
+                success = false;
+                break;
+            }
+        }
+
+        if (!success) {
+            result.clear();
+        }
+
+        return result;
+    }
+
+
+    const char* Engine::input() const {
+        return inputCopied ? inputBuffer.data() : inputData;
+    }
+
+
+    unsigned long Engine::inputLength() const {
+        return inputCopied ? static_cast<unsigned long>(inputBuffer.size()) : inputDataLength;
+    }
+
+
+    unsigned long Engine::maximumOutputLength() const {
+        unsigned long length = inputLength();
+
+        if (currentUtf8Policy == Utf8Policy::REPLACE) {
+            length = Utf8::replacedLength(input(), length);
+        }
+
+        return length + paddingLength;
+    }
+
+
+    void Engine::update(const char* inputPointer, unsigned long charsToCopy) {
+        if (currentSink != nullptr) {
+            currentSink->update(inputPointer, charsToCopy);
+        }
+    }
+
+
+    void Engine::setStaging(bool enabled) {
+        stagingEnabled = enabled;
+    }
+
+
+    template<Engine::Backend scrubBackend> bool Engine::scrubUsing() {
+        char* writablePointer = currentInputMode == InputMode::COPY ? padInput() : nullptr;
+
+        const char*   basePointer  = input();
+        unsigned long inputBase    = 0;
+        unsigned long inputIndex   = 0;
+        unsigned long inputLength  = Engine::inputLength();
+        unsigned long outputLength = 0;
+        bool          validUtf8    = Utf8::validate(basePointer, inputLength);
+        captureMode  = CaptureMode::IN_TEXT;
+
+        if (!validUtf8 && currentUtf8Policy == Utf8Policy::REJECT) {
+            return false;
+        }
+
+        /*
+         * The block parallel back-end falls through to the transition table below whenever scrubChunks declines the
+         * input.  It always declines in builds without AVX-512 VBMI, which is the default, see the vbmi option in
+         * inehtml_scrubber.pro.
+         */
+        if (scrubBackend == Backend::PARALLEL && validUtf8 && scrubChunks(basePointer, writablePointer, inputLength)) {
+            return true;
+        }
+
+        reset();
+
+        while (inputIndex < inputLength) {
+            char c = basePointer[inputIndex];
+
+            if ((c & 0x80) == 0x00) {
+                scrubStep<scrubBackend>(basePointer, writablePointer, inputLength, inputBase, inputIndex, outputLength);
+            } else if (validUtf8) {
+                unsigned long length = Utf8::nonAsciiLength(basePointer + inputIndex, inputLength - inputIndex);
+
+                if (captureMode != CaptureMode::IGNORE) {
+                    outputLength += length;
+                }
+
+                inputIndex += length;
+            } else if (currentUtf8Policy == Utf8Policy::REPLACE) {
+                bool          validSequence;
+                unsigned long length = Utf8::decode(basePointer + inputIndex, inputLength - inputIndex, validSequence);
+
+                if (captureMode != CaptureMode::IGNORE) {
+                    if (validSequence) {
+                        outputLength += length;
+                    } else {
+                        if (outputLength > 0) {
+                            writeOutput(basePointer + inputBase, outputLength);
+                            outputLength = 0;
+                        }
+
+                        writeOutput(Utf8::replacementCharacter, sizeof(Utf8::replacementCharacter));
+                        inputBase = inputIndex + length;
+                    }
+                }
+
+                inputIndex += length;
             } else if ((c & 0xE0) == 0xC0) {
                 if (captureMode != CaptureMode::IGNORE) {
                     outputLength += 2;
@@ -101,19 +659,391 @@ namespace HtmlScrubber {
             }
         }
 
+        finishOutput(
+            basePointer,
+            inputBase,
+            outputLength,
+            inputIndex - inputLength,
+            currentInputMode == InputMode::READ_ONLY
+        );
+
+        return true;
+    }
+
+
+    template<Engine::Backend scrubBackend> bool Engine::runsUsing(std::vector<Engine::Run>& result) {
+        const char*   basePointer = input();
+        unsigned long inputIndex  = 0;
+        unsigned long inputLength = Engine::inputLength();
+        bool          validUtf8   = Utf8::validate(basePointer, inputLength);
+        captureMode = CaptureMode::IN_TEXT;
+
+        if (!validUtf8 && currentUtf8Policy == Utf8Policy::REJECT) {
+            return false;
+        }
+
+        reset();
+
+        while (inputIndex < inputLength) {
+            char c = basePointer[inputIndex];
+
+            if ((c & 0x80) == 0x00) {
+                char value = c;
+
+                if (scrubBackend == Backend::SWITCH) {
+                    parse(value);
+                } else {
+                    parseTable(value);
+                }
+
+                RunKind kind = runKind(captureMode);
+
+                if (kind != RunKind::IGNORED && value != c) {
+                    appendRun(result, inputIndex, 1, RunKind::MARKER, value);
+                } else {
+                    appendRun(result, inputIndex, 1, kind);
+                }
+
+                ++inputIndex;
+
+                unsigned long skipped = advance(basePointer + inputIndex, inputLength - inputIndex);
+                appendRun(result, inputIndex, skipped, runKind(captureMode));
+                inputIndex += skipped;
+            } else if (validUtf8) {
+                unsigned long length = Utf8::nonAsciiLength(basePointer + inputIndex, inputLength - inputIndex);
+                appendRun(result, inputIndex, length, runKind(captureMode));
+                inputIndex += length;
+            } else if (currentUtf8Policy == Utf8Policy::REPLACE) {
+                bool          validSequence;
+                unsigned long length = Utf8::decode(basePointer + inputIndex, inputLength - inputIndex, validSequence);
+                RunKind       kind   = runKind(captureMode);
+
+                if (kind != RunKind::IGNORED && !validSequence) {
+                    appendRun(result, inputIndex, length, RunKind::REPLACEMENT);
+                } else {
+                    appendRun(result, inputIndex, length, kind);
+                }
+
+                inputIndex += length;
+            } else {
+                unsigned long length;
+
+                if ((c & 0xE0) == 0xC0) {
+                    length = 2;
+                } else if ((c & 0xF0) == 0xE0) {
+                    length = 3;
+                } else if ((c & 0xF8) == 0xF0) {
+                    length = 4;
+                } else {
+                    length = 1;
+                }
+
+                if (length > inputLength + paddingLength - inputIndex) {
+                    length = inputLength + paddingLength - inputIndex;
+                }
+
+                appendRun(result, inputIndex, length, runKind(captureMode));
+                inputIndex += length;
+            }
+        }
+
+        for (unsigned long index=inputIndex ; index<inputLength + paddingLength ; ++index) {
+            char c     = padding[index - inputLength];
+            char value = c;
+
+            if (scrubBackend == Backend::SWITCH) {
+                parse(value);
+            } else {
+                parseTable(value);
+            }
+
+            RunKind kind = runKind(captureMode);
+
+            if (kind != RunKind::IGNORED && value != c) {
+                appendRun(result, index, 1, RunKind::MARKER, value);
+            } else {
+                appendRun(result, index, 1, kind);
+            }
+        }
+
+        return true;
+    }
+
+
+    void Engine::copyInput() {
+        inputBuffer.reserve(inputDataLength + paddingLength);
+        inputBuffer.assign(inputData, inputData + inputDataLength);
+
+        inputCopied = true;
+    }
+
+
+    char* Engine::padInput() {
+        if (!inputCopied) {
+            copyInput();
+        }
+
+        inputBuffer.insert(inputBuffer.end(), padding, padding + paddingLength);
+        return inputBuffer.data();
+    }
+
+
+    bool Engine::scrubChunks(const char* basePointer, char* writablePointer, unsigned long inputLength) {
+        if (!StateMap::accelerated() || inputLength / parallelChunkLength < 2) {
+            return false;
+        }
+
+        WorkerThreads workers(static_cast<unsigned>(inputLength / parallelChunkLength - 1));
+
+        if (workers.count() == 0) {
+            return false;
+        }
+
+        const StateMap& chunkStateMap = stateMap();
+        unsigned        numberChunks  = workers.count() + 1;
+        unsigned long   chunkLength   = inputLength / numberChunks;
+
+        std::vector<unsigned long>  chunkStarts(numberChunks + 1);
+        std::vector<StateMap::Map>  maps(numberChunks - 1);
+        std::vector<States>         entryStates(numberChunks);
+        std::vector<CaptureMode>    entryCaptures(numberChunks);
+        std::vector<SpanSink>       chunkOutputs(numberChunks);
+        States                      exitState   = States::IN_TEXT_SPACE;
+        CaptureMode                 exitCapture = CaptureMode::IN_TEXT;
+
+        for (unsigned chunk=0 ; chunk<numberChunks ; ++chunk) {
+            unsigned long chunkStart = chunk * chunkLength;
+
+            /*
+             * Move the split past any continuation bytes so no chunk starts inside a multi-byte sequence.
+             */
+            while (chunkStart < inputLength && (basePointer[chunkStart] & 0xC0) == 0x80) {
+                ++chunkStart;
+            }
+
+            chunkStarts[chunk] = chunkStart;
+        }
+
+        chunkStarts[numberChunks] = inputLength;
+
+        runChunks(0, numberChunks - 1, [&](unsigned chunk) {
+            StateMap::identity(maps[chunk]);
+            chunkStateMap.apply(
+                maps[chunk],
+                basePointer + chunkStarts[chunk],
+                chunkStarts[chunk + 1] - chunkStarts[chunk]
+            );
+        });
+
+        entryStates[0]   = States::IN_TEXT_SPACE;
+        entryCaptures[0] = CaptureMode::IN_TEXT;
+
+        for (unsigned chunk=1 ; chunk<numberChunks ; ++chunk) {
+            const StateMap::Map& map        = maps[chunk - 1];
+            unsigned             stateIndex = static_cast<unsigned>(entryStates[chunk - 1]);
+            std::uint8_t         capture    = map.captures[stateIndex];
+
+            entryStates[chunk]   = static_cast<States>(map.states[stateIndex]);
+            entryCaptures[chunk] = entryCaptures[chunk - 1];
+
+            if (capture != StateMap::keepCapture) {
+                entryCaptures[chunk] = static_cast<CaptureMode>(capture - 1);
+            }
+        }
+
+        runChunks(0, numberChunks, [&](unsigned chunk) {
+            if (chunk == 0) {
+                reset();
+                scrubRange(basePointer, writablePointer, 0, chunkStarts[1], entryStates[0], entryCaptures[0]);
+            } else {
+                Engine worker(basePointer, inputLength, InputMode::READ_ONLY);
+                worker.setSink(&chunkOutputs[chunk]);
+                worker.scrubRange(
+                    basePointer,
+                    writablePointer,
+                    chunkStarts[chunk],
+                    chunkStarts[chunk + 1],
+                    entryStates[chunk],
+                    entryCaptures[chunk]
+                );
+
+                if (chunk == numberChunks - 1) {
+                    exitState   = worker.state();
+                    exitCapture = worker.captureMode;
+                }
+            }
+        });
+
+        for (unsigned chunk=1 ; chunk<numberChunks ; ++chunk) {
+            for (const SpanSink::Span& span : chunkOutputs[chunk].spans()) {
+                writeOutput(span.data, span.length);
+            }
+        }
+
+        setState(exitState);
+        captureMode = exitCapture;
+
+        finishOutput(basePointer, 0, 0, 0, currentInputMode == InputMode::READ_ONLY);
+        return true;
+    }
+
+
+    void Engine::scrubRange(
+            const char*   basePointer,
+            char*         writablePointer,
+            unsigned long rangeStart,
+            unsigned long rangeEnd,
+            States        entryState,
+            CaptureMode   entryCapture
+        ) {
+        unsigned long inputBase    = rangeStart;
+        unsigned long inputIndex   = rangeStart;
+        unsigned long outputLength = 0;
+
+        assert(rangeStart == rangeEnd || (basePointer[rangeStart] & 0xC0) != 0x80);
+
+        setState(entryState);
+        captureMode = entryCapture;
+
+        while (inputIndex < rangeEnd) {
+            char c = basePointer[inputIndex];
+
+            if ((c & 0x80) == 0x00) {
+                scrubStep<Backend::TABLE>(basePointer, writablePointer, rangeEnd, inputBase, inputIndex, outputLength);
+            } else {
+                unsigned long length = Utf8::nonAsciiLength(basePointer + inputIndex, rangeEnd - inputIndex);
+
+                if (captureMode != CaptureMode::IGNORE) {
+                    outputLength += length;
+                }
+
+                inputIndex += length;
+            }
+        }
+
+        if (captureMode != CaptureMode::IGNORE) {
+            writeOutput(basePointer + inputBase, outputLength);
+        }
+    }
+
+
+    void Engine::finishOutput(
+            const char*   basePointer,
+            unsigned long inputBase,
+            unsigned long outputLength,
+            unsigned long overflow,
+            bool          simulatePadding
+        ) {
         if (captureMode != CaptureMode::IGNORE) {
-            update(basePointer + inputBase, outputLength);
+            writeOutput(basePointer + inputBase, outputLength - overflow);
+            writeOutput(padding, overflow);
         }
+
+        if (simulatePadding) {
+            for (unsigned long index=overflow ; index<paddingLength ; ++index) {
+                char c = padding[index];
+                parseTable(c);
+
+                if (captureMode != CaptureMode::IGNORE) {
+                    writeOutput(byteValue(c), 1);
+                }
+            }
+        }
+
+        flushOutput();
+    }
+
+
+    const StateMap& Engine::stateMap() {
+        static const std::uint8_t hookCaptures[] = {
+            StateMap::keepCapture,                                        // NONE
+            static_cast<std::uint8_t>(CaptureMode::IGNORE) + 1,           // START_TAG
+            static_cast<std::uint8_t>(CaptureMode::IGNORE) + 1,           // MULTIPLE_WHITE_SPACE
+            StateMap::keepCapture,                                        // WHITESPACE
+            static_cast<std::uint8_t>(CaptureMode::IN_TEXT) + 1,          // RESUME_TEXT
+            StateMap::keepCapture,                                        // END_TAG
+            static_cast<std::uint8_t>(CaptureMode::IN_URL) + 1,           // START_SRC_ATTRIBUTE
+            static_cast<std::uint8_t>(CaptureMode::IGNORE) + 1,           // END_SRC_ATTRIBUTE
+            static_cast<std::uint8_t>(CaptureMode::IN_URL) + 1,           // START_HREF_ATTRIBUTE
+            static_cast<std::uint8_t>(CaptureMode::IGNORE) + 1,           // END_HREF_ATTRIBUTE
+            static_cast<std::uint8_t>(CaptureMode::IN_URL) + 1,           // START_CITE_ATTRIBUTE
+            static_cast<std::uint8_t>(CaptureMode::IGNORE) + 1,           // END_CITE_ATTRIBUTE
+            static_cast<std::uint8_t>(CaptureMode::IN_URL) + 1,           // START_SCRIPT_SRC_ATTRIBUTE
+            static_cast<std::uint8_t>(CaptureMode::IGNORE) + 1,           // END_SCRIPT_SRC_ATTRIBUTE
+            static_cast<std::uint8_t>(CaptureMode::IN_STYLE) + 1,         // START_STYLE
+            static_cast<std::uint8_t>(CaptureMode::IGNORE) + 1            // END_STYLE
+        };
+
+        static const StateMap map(hookCaptures);
+        return map;
     }
 
 
-    const QByteArray& Engine::input() const {
-        return inputData;
+    const char* Engine::byteValue(char c) {
+        return byteValues.values + static_cast<std::uint8_t>(c);
     }
 
 
-    QByteArray& Engine::input() {
-        return inputData;
+    void Engine::appendRun(
+            std::vector<Engine::Run>& result,
+            unsigned long             offset,
+            unsigned long             length,
+            Engine::RunKind           kind,
+            char                      value
+        ) {
+        if (length > 0) {
+            if (!result.empty()                             &&
+                kind != RunKind::MARKER                     &&
+                kind != RunKind::REPLACEMENT                &&
+                result.back().kind == kind                  &&
+                result.back().offset + result.back().length == offset) {
+                result.back().length += length;
+            } else {
+                Run run;
+                run.offset = offset;
+                run.length = length;
+                run.kind   = kind;
+                run.value  = value;
+
+                result.push_back(run);
+            }
+        }
+    }
+
+
+    Engine::RunKind Engine::runKind(Engine::CaptureMode mode) {
+        RunKind result;
+
+        switch (mode) {
+            case CaptureMode::IGNORE: {
+                result = RunKind::IGNORED;
+                break;
+            }
+
+            case CaptureMode::IN_TEXT:
+            case CaptureMode::IN_SCRIPT: {
+                result = RunKind::TEXT;
+                break;
+            }
+
+            case CaptureMode::IN_STYLE: {
+                result = RunKind::STYLE;
+                break;
+            }
+
+            case CaptureMode::IN_URL: {
+                result = RunKind::URL;
+                break;
+            }
+
+            default: {
+                assert(false);
+                result = RunKind::IGNORED;
+                break;
+            }
+        }
+
+        return result;
     }
 
 
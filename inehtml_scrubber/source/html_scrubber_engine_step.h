@@ -0,0 +1,129 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+********************************************************************************************************************//**
+* \file
+*
+* This header provides the per-byte scrubbing step shared by the \ref HtmlScrubber::Engine scrubbing loops.
+***********************************************************************************************************************/
+
+/* .. sphinx-project inehtmlscrubber */
+
+#ifndef HTML_SCRUBBER_ENGINE_STEP_H
+#define HTML_SCRUBBER_ENGINE_STEP_H
+
+#include "html_scrubber_parser.h"
+#include "html_scrubber_static_parser.h"
+#include "html_scrubber_keyword_matcher.h"
+#include "html_scrubber_scanner.h"
+#include "html_scrubber_engine.h"
+
+/*
+ * The step is called once per ASCII byte from several loops and is too large for the compiler to inline by itself.
+ */
+#if (defined(_MSC_VER))
+    #define HTML_SCRUBBER_STEP_INLINE __forceinline
+#else
+    #define HTML_SCRUBBER_STEP_INLINE inline __attribute__((always_inline))
+#endif
+
+namespace HtmlScrubber {
+    template<Engine::Backend scrubBackend> HTML_SCRUBBER_STEP_INLINE void Engine::scrubStep(
+            const char*    basePointer,
+            char*          writablePointer,
+            unsigned long  endIndex,
+            unsigned long& inputBase,
+            unsigned long& inputIndex,
+            unsigned long& outputLength
+        ) {
+        char        c               = basePointer[inputIndex];
+        CaptureMode lastCaptureMode = captureMode;
+
+        if (scrubBackend == Backend::SWITCH) {
+            parse(c);
+        } else {
+            parseTable(c);
+        }
+
+        captureStep(basePointer, writablePointer, c, lastCaptureMode, endIndex, inputBase, inputIndex, outputLength);
+    }
+
+
+    HTML_SCRUBBER_STEP_INLINE void Engine::captureStep(
+            const char*    basePointer,
+            char*          writablePointer,
+            char           c,
+            CaptureMode    lastCaptureMode,
+            unsigned long  endIndex,
+            unsigned long& inputBase,
+            unsigned long& inputIndex,
+            unsigned long& outputLength
+        ) {
+        if (captureMode == CaptureMode::IGNORE) {
+            if (lastCaptureMode != CaptureMode::IGNORE) {
+                writeOutput(basePointer + inputBase, outputLength);
+                outputLength = 0;
+            }
+        } else {
+            ++outputLength;
+
+            if (lastCaptureMode == CaptureMode::IGNORE) {
+                inputBase = inputIndex;
+            }
+        }
+
+        if (c != basePointer[inputIndex]) {
+            if (writablePointer != nullptr) {
+                writablePointer[inputIndex] = c;
+            } else if (captureMode != CaptureMode::IGNORE) {
+                writeOutput(basePointer + inputBase, outputLength - 1);
+                writeOutput(byteValue(c), 1);
+
+                inputBase    = inputIndex + 1;
+                outputLength = 0;
+            }
+        }
+
+        ++inputIndex;
+
+        unsigned long skipped = advance(basePointer + inputIndex, endIndex - inputIndex);
+
+        if (captureMode != CaptureMode::IGNORE) {
+            outputLength += skipped;
+        }
+
+        inputIndex += skipped;
+    }
+
+
+    HTML_SCRUBBER_STEP_INLINE unsigned long Engine::advance(const char* data, unsigned long length) {
+        States        keywordState;
+        unsigned long matched = KeywordMatcher::match(state(), data, length, keywordState);
+
+        if (matched > 0) {
+            setState(keywordState);
+        }
+
+        unsigned long         skipped    = 0;
+        Scanner::DelimiterSet delimiters = Scanner::delimiterSet(state());
+
+        if (delimiters != Scanner::DelimiterSet::NONE) {
+            skipped = Scanner::skip(delimiters, data + matched, length - matched);
+        }
+
+        return matched + skipped;
+    }
+};
+#endif
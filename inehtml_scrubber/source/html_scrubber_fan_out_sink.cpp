@@ -0,0 +1,73 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the fan-out sink.
+***********************************************************************************************************************/
+
+#include <algorithm>
+#include <vector>
+
+#include "html_scrubber_sink.h"
+#include "html_scrubber_fan_out_sink.h"
+
+namespace HtmlScrubber {
+    FanOutSink::FanOutSink() {}
+
+
+    FanOutSink::~FanOutSink() {}
+
+
+    void FanOutSink::addSink(Sink* sink) {
+        currentSinks.push_back(sink);
+    }
+
+
+    void FanOutSink::removeSink(Sink* sink) {
+        currentSinks.erase(std::remove(currentSinks.begin(), currentSinks.end(), sink), currentSinks.end());
+    }
+
+
+    void FanOutSink::clearSinks() {
+        currentSinks.clear();
+    }
+
+
+    const std::vector<Sink*>& FanOutSink::sinks() const {
+        return currentSinks;
+    }
+
+
+    bool FanOutSink::retainsData() const {
+        bool result = false;
+
+        for (const Sink* sink : currentSinks) {
+            if (sink->retainsData()) {
+                result = true;
+                break;
+            }
+        }
+
+        return result;
+    }
+
+
+    void FanOutSink::update(const char* data, unsigned long length) {
+        for (Sink* sink : currentSinks) {
+            sink->update(data, length);
+        }
+    }
+}
@@ -0,0 +1,47 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the XXH64 hash sink.
+***********************************************************************************************************************/
+
+#include <cstdint>
+
+#include "html_scrubber_sink.h"
+#include "html_scrubber_xxh64.h"
+#include "html_scrubber_fast_hash_sink.h"
+
+namespace HtmlScrubber {
+    FastHashSink::FastHashSink(std::uint64_t seed):hashState(seed) {}
+
+
+    FastHashSink::~FastHashSink() {}
+
+
+    void FastHashSink::update(const char* data, unsigned long length) {
+        hashState.addData(data, length);
+    }
+
+
+    void FastHashSink::reset(std::uint64_t seed) {
+        hashState.reset(seed);
+    }
+
+
+    std::uint64_t FastHashSink::result() const {
+        return hashState.result();
+    }
+}
@@ -0,0 +1,156 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the fast hasher.
+***********************************************************************************************************************/
+
+#include <QtGlobal>
+#include <QByteArray>
+#include <QString>
+
+#include <cstdint>
+
+#include "html_scrubber_engine.h"
+#include "html_scrubber_xxh64.h"
+#include "html_scrubber_mapped_file.h"
+#include "html_scrubber_fast_hasher.h"
+
+namespace HtmlScrubber {
+    FastHasher::FastHasher():Engine(nullptr, 0), currentSeed(0) {}
+
+
+    FastHasher::FastHasher(
+            const QByteArray&     rawData,
+            FastHasher::InputMode inputMode
+        ):Engine(
+            rawData.constData(),
+            static_cast<unsigned long>(rawData.size()),
+            inputMode
+        ), currentSeed(
+            0
+        ), inputData(
+            rawData
+        ) {}
+
+
+    FastHasher::FastHasher(const char* rawData, unsigned long length):Engine(rawData, length), currentSeed(0) {}
+
+
+    FastHasher::~FastHasher() {}
+
+
+    void FastHasher::setSeed(std::uint64_t newSeed) {
+        currentSeed = newSeed;
+    }
+
+
+    std::uint64_t FastHasher::seed() const {
+        return currentSeed;
+    }
+
+
+    void FastHasher::setInput(const QByteArray& rawData, FastHasher::InputMode inputMode) {
+        inputData = rawData;
+        Engine::setInput(inputData.constData(), static_cast<unsigned long>(inputData.size()), inputMode);
+    }
+
+
+    void FastHasher::setInput(const char* rawData, unsigned long length) {
+        inputData = QByteArray();
+        Engine::setInput(rawData, length);
+    }
+
+
+    bool FastHasher::scrubAndHash() {
+        hashState.reset(currentSeed);
+        return Engine::scrub();
+    }
+
+
+    void FastHasher::begin() {
+        hashState.reset(currentSeed);
+        Engine::begin();
+    }
+
+
+    bool FastHasher::finish() {
+        return Engine::finish();
+    }
+
+
+    std::uint64_t FastHasher::result() const {
+        return hashState.result();
+    }
+
+
+    bool FastHasher::scrubAndHash(
+            const char*            rawData,
+            unsigned long          length,
+            std::uint64_t&         hash,
+            FastHasher::Backend    scrubBackend,
+            FastHasher::Utf8Policy scrubPolicy
+        ) {
+        FastHasher hasher(rawData, length);
+        hasher.setBackend(scrubBackend);
+        hasher.setUtf8Policy(scrubPolicy);
+
+        bool success = hasher.scrubAndHash();
+        if (success) {
+            hash = hasher.result();
+        }
+
+        return success;
+    }
+
+
+    bool FastHasher::scrubAndHash(
+            const QByteArray&      rawData,
+            std::uint64_t&         hash,
+            FastHasher::Backend    scrubBackend,
+            FastHasher::Utf8Policy scrubPolicy
+        ) {
+        return scrubAndHash(
+            rawData.constData(),
+            static_cast<unsigned long>(rawData.size()),
+            hash,
+            scrubBackend,
+            scrubPolicy
+        );
+    }
+
+
+    bool FastHasher::scrubAndHashFile(
+            const QString&         filename,
+            std::uint64_t&         hash,
+            FastHasher::Backend    scrubBackend,
+            FastHasher::Utf8Policy scrubPolicy
+        ) {
+        bool       success = false;
+        MappedFile mappedFile(filename);
+
+        if (mappedFile.isValid()) {
+            success = scrubAndHash(mappedFile.data(), mappedFile.size(), hash, scrubBackend, scrubPolicy);
+        }
+
+        return success;
+    }
+
+
+    void FastHasher::update(const char* inputPointer, unsigned long charsToCopy) {
+        hashState.addData(inputPointer, charsToCopy);
+    }
+}
@@ -22,41 +22,347 @@
 #include <QByteArray>
 #include <QString>
 #include <QCryptographicHash>
+#include <QList>
 
 #include <cstdint>
 #include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include "html_scrubber_engine.h"
+#include "html_scrubber_digest.h"
+#include "html_scrubber_chunk_hash_sink.h"
+#include "html_scrubber_sim_hash_sink.h"
+#include "html_scrubber_fast_hasher.h"
+#include "html_scrubber_mapped_file.h"
 #include "html_scrubber_hasher.h"
 
 namespace HtmlScrubber {
     Hasher::Hasher(
-            const QByteArray& rawData,
             Hasher::Algorithm hashAlgorithm
         ):Engine(
+            nullptr,
+            0
+        ), QCryptographicHash(
+            hashAlgorithm
+        ), chunkHashingEnabled(
+            false
+        ), chunkHashingActive(
+            false
+        ), simHashingEnabled(
+            false
+        ), simHashingActive(
+            false
+        ) {}
+
+
+    Hasher::Hasher(
+            const QByteArray& rawData,
+            Hasher::Algorithm hashAlgorithm,
+            Hasher::InputMode inputMode
+        ):Engine(
+            rawData.constData(),
+            static_cast<unsigned long>(rawData.size()),
+            inputMode
+        ), QCryptographicHash(
+            hashAlgorithm
+        ), inputData(
             rawData
+        ), chunkHashingEnabled(
+            false
+        ), chunkHashingActive(
+            false
+        ), simHashingEnabled(
+            false
+        ), simHashingActive(
+            false
+        ) {}
+
+
+    Hasher::Hasher(
+            const char*       rawData,
+            unsigned long     length,
+            Hasher::Algorithm hashAlgorithm
+        ):Engine(
+            rawData,
+            length
         ), QCryptographicHash(
             hashAlgorithm
+        ), chunkHashingEnabled(
+            false
+        ), chunkHashingActive(
+            false
+        ), simHashingEnabled(
+            false
+        ), simHashingActive(
+            false
         ) {}
 
 
     Hasher::~Hasher() {}
 
 
-    void Hasher::scrubAndHash() {
-        QCryptographicHash::reset();
-        Engine::scrub();
+    void Hasher::setInput(const QByteArray& rawData, Hasher::InputMode inputMode) {
+        inputData = rawData;
+        Engine::setInput(inputData.constData(), static_cast<unsigned long>(inputData.size()), inputMode);
+    }
+
+
+    void Hasher::setInput(const char* rawData, unsigned long length) {
+        inputData = QByteArray();
+        Engine::setInput(rawData, length);
+    }
+
+
+    void Hasher::setChunkHashing(bool nowEnabled) {
+        chunkHashingEnabled = nowEnabled;
+    }
+
+
+    bool Hasher::chunkHashing() const {
+        return chunkHashingEnabled;
     }
 
 
-    QByteArray Hasher::scrubAndHash(const QByteArray& rawData, Hasher::Algorithm hashAlgorithm) {
-        Hasher hasher(rawData, hashAlgorithm);
-        hasher.scrubAndHash();
-        return hasher.result();
+    const std::vector<Hasher::Chunk>& Hasher::chunks() const {
+        return chunkHashSink.chunks();
+    }
+
+
+    void Hasher::setSimHashing(bool nowEnabled) {
+        simHashingEnabled = nowEnabled;
+    }
+
+
+    bool Hasher::simHashing() const {
+        return simHashingEnabled;
+    }
+
+
+    std::uint64_t Hasher::simHash() const {
+        return simHashSink.result();
+    }
+
+
+    bool Hasher::scrubAndHash() {
+        startDocument();
+
+        bool success = Engine::scrub();
+        finishSinks();
+
+        return success;
+    }
+
+
+    void Hasher::begin() {
+        startDocument();
+        Engine::begin();
+    }
+
+
+    QByteArray Hasher::finish() {
+        bool success = Engine::finish();
+        finishSinks();
+
+        return success ? result() : QByteArray();
+    }
+
+
+    Digest Hasher::digest() const {
+        #if (QT_VERSION >= QT_VERSION_CHECK(6, 3, 0))
+            QByteArrayView hash = resultView();
+        #else
+            QByteArray hash = result();
+        #endif
+
+        return Digest(hash.constData(), static_cast<unsigned long>(hash.size()));
+    }
+
+
+    QByteArray Hasher::scrubAndHash(
+            const QByteArray&  rawData,
+            Hasher::Algorithm  hashAlgorithm,
+            Hasher::Backend    scrubBackend,
+            Hasher::Utf8Policy scrubPolicy
+        ) {
+        Hasher& hasher = pooledHasher(hashAlgorithm);
+        hasher.setInput(rawData, InputMode::READ_ONLY);
+        hasher.setBackend(scrubBackend);
+        hasher.setUtf8Policy(scrubPolicy);
+
+        QByteArray result = hasher.scrubAndHash() ? hasher.result() : QByteArray();
+        hasher.setInput(nullptr, 0);
+
+        return result;
+    }
+
+
+    Digest Hasher::scrubAndDigest(
+            const char*        rawData,
+            unsigned long      length,
+            Hasher::Algorithm  hashAlgorithm,
+            Hasher::Backend    scrubBackend,
+            Hasher::Utf8Policy scrubPolicy
+        ) {
+        Hasher& hasher = pooledHasher(hashAlgorithm);
+        hasher.setInput(rawData, length);
+        hasher.setBackend(scrubBackend);
+        hasher.setUtf8Policy(scrubPolicy);
+
+        Digest result = hasher.scrubAndHash() ? hasher.digest() : Digest();
+        hasher.setInput(nullptr, 0);
+
+        return result;
+    }
+
+
+    Digest Hasher::scrubAndDigest(
+            const QByteArray&  rawData,
+            Hasher::Algorithm  hashAlgorithm,
+            Hasher::Backend    scrubBackend,
+            Hasher::Utf8Policy scrubPolicy
+        ) {
+        return scrubAndDigest(
+            rawData.constData(),
+            static_cast<unsigned long>(rawData.size()),
+            hashAlgorithm,
+            scrubBackend,
+            scrubPolicy
+        );
+    }
+
+
+    QByteArray Hasher::scrubAndHashFile(
+            const QString&     filename,
+            Hasher::Algorithm  hashAlgorithm,
+            Hasher::Backend    scrubBackend,
+            Hasher::Utf8Policy scrubPolicy
+        ) {
+        QByteArray result;
+        MappedFile mappedFile(filename);
+
+        if (mappedFile.isValid()) {
+            Hasher& hasher = pooledHasher(hashAlgorithm);
+            hasher.setInput(mappedFile.data(), mappedFile.size());
+            hasher.setBackend(scrubBackend);
+            hasher.setUtf8Policy(scrubPolicy);
+
+            if (hasher.scrubAndHash()) {
+                result = hasher.result();
+            }
+
+            hasher.setInput(nullptr, 0);
+        }
+
+        return result;
+    }
+
+
+    bool Hasher::scrubAndHash(
+            const char*        rawData,
+            unsigned long      length,
+            std::uint64_t&     hash,
+            Hasher::Backend    scrubBackend,
+            Hasher::Utf8Policy scrubPolicy
+        ) {
+        return FastHasher::scrubAndHash(rawData, length, hash, scrubBackend, scrubPolicy);
+    }
+
+
+    bool Hasher::scrubAndHash(
+            const QByteArray&  rawData,
+            std::uint64_t&     hash,
+            Hasher::Backend    scrubBackend,
+            Hasher::Utf8Policy scrubPolicy
+        ) {
+        return FastHasher::scrubAndHash(rawData, hash, scrubBackend, scrubPolicy);
+    }
+
+
+    bool Hasher::scrubAndHashFile(
+            const QString&     filename,
+            std::uint64_t&     hash,
+            Hasher::Backend    scrubBackend,
+            Hasher::Utf8Policy scrubPolicy
+        ) {
+        return FastHasher::scrubAndHashFile(filename, hash, scrubBackend, scrubPolicy);
+    }
+
+
+    QList<QByteArray> Hasher::scrubAndHash(
+            const QList<QByteArray>& rawData,
+            Hasher::Algorithm        hashAlgorithm,
+            Hasher::Utf8Policy       scrubPolicy
+        ) {
+        Hasher& hasher = pooledHasher(hashAlgorithm);
+        hasher.setBackend(Backend::SWITCH);
+        hasher.setUtf8Policy(scrubPolicy);
+
+        QList<QByteArray> result;
+        result.reserve(rawData.size());
+
+        for (const QByteArray& document : rawData) {
+            hasher.setInput(document, InputMode::READ_ONLY);
+            result.append(hasher.scrubAndHash() ? hasher.result() : QByteArray());
+        }
+
+        hasher.setInput(nullptr, 0);
+
+        return result;
+    }
+
+
+    Hasher& Hasher::pooledHasher(Hasher::Algorithm hashAlgorithm) {
+        thread_local std::vector<std::pair<Algorithm, std::unique_ptr<Hasher>>> hashers;
+
+        Hasher* hasher = nullptr;
+        for (const std::pair<Algorithm, std::unique_ptr<Hasher>>& entry : hashers) {
+            if (entry.first == hashAlgorithm) {
+                hasher = entry.second.get();
+                break;
+            }
+        }
+
+        if (hasher == nullptr) {
+            hasher = new Hasher(hashAlgorithm);
+            hashers.emplace_back(hashAlgorithm, std::unique_ptr<Hasher>(hasher));
+        }
+
+        return *hasher;
     }
 
 
     void Hasher::update(const char* inputPointer, unsigned long charsToCopy) {
         QCryptographicHash::addData(inputPointer, charsToCopy);
+
+        if (chunkHashingActive) {
+            chunkHashSink.update(inputPointer, charsToCopy);
+        }
+
+        if (simHashingActive) {
+            simHashSink.update(inputPointer, charsToCopy);
+        }
+    }
+
+
+    void Hasher::startDocument() {
+        QCryptographicHash::reset();
+        chunkHashSink.clear();
+        simHashSink.clear();
+
+        chunkHashingActive = chunkHashingEnabled;
+        simHashingActive   = simHashingEnabled;
+    }
+
+
+    void Hasher::finishSinks() {
+        if (chunkHashingActive) {
+            chunkHashSink.finish();
+        }
+
+        if (simHashingActive) {
+            simHashSink.finish();
+        }
     }
 }
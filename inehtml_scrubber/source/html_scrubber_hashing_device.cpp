@@ -0,0 +1,123 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the hashing device.
+***********************************************************************************************************************/
+
+#include <QtGlobal>
+#include <QObject>
+#include <QByteArray>
+#include <QIODevice>
+#include <QCryptographicHash>
+
+#include "html_scrubber_hasher.h"
+#include "html_scrubber_hashing_device.h"
+
+namespace HtmlScrubber {
+    HashingDevice::HashingDevice(
+            QCryptographicHash::Algorithm hashAlgorithm,
+            QObject*                      parent
+        ):QIODevice(
+            parent
+        ), currentHasher(
+            hashAlgorithm
+        ), currentBackend(
+            Backend::SWITCH
+        ), currentUtf8Policy(
+            Utf8Policy::PASS_THROUGH
+        ) {}
+
+
+    HashingDevice::~HashingDevice() {}
+
+
+    void HashingDevice::setBackend(HashingDevice::Backend newBackend) {
+        currentBackend = newBackend;
+    }
+
+
+    HashingDevice::Backend HashingDevice::backend() const {
+        return currentBackend;
+    }
+
+
+    void HashingDevice::setUtf8Policy(HashingDevice::Utf8Policy newUtf8Policy) {
+        currentUtf8Policy = newUtf8Policy;
+    }
+
+
+    HashingDevice::Utf8Policy HashingDevice::utf8Policy() const {
+        return currentUtf8Policy;
+    }
+
+
+    bool HashingDevice::open(QIODevice::OpenMode mode) {
+        bool success;
+
+        if (mode.testFlag(QIODevice::ReadOnly)) {
+            setErrorString(tr("HashingDevice is write only."));
+            success = false;
+        } else {
+            currentResult.clear();
+            currentHasher.setBackend(currentBackend);
+            currentHasher.setUtf8Policy(currentUtf8Policy);
+            currentHasher.begin();
+
+            success = QIODevice::open(mode | QIODevice::Unbuffered);
+        }
+
+        return success;
+    }
+
+
+    void HashingDevice::close() {
+        if (isOpen()) {
+            currentResult = currentHasher.finish();
+        }
+
+        QIODevice::close();
+    }
+
+
+    bool HashingDevice::isSequential() const {
+        return true;
+    }
+
+
+    QByteArray HashingDevice::result() const {
+        return currentResult;
+    }
+
+
+    qint64 HashingDevice::readData(char* /* data */, qint64 /* maxSize */) {
+        return -1;
+    }
+
+
+    qint64 HashingDevice::writeData(const char* data, qint64 maxSize) {
+        qint64 result;
+
+        if (currentHasher.feed(data, static_cast<unsigned long>(maxSize))) {
+            result = maxSize;
+        } else {
+            setErrorString(tr("Document contains invalid UTF-8."));
+            result = -1;
+        }
+
+        return result;
+    }
+}
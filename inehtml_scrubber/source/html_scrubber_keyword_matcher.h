@@ -0,0 +1,232 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides packed word matching of the tag and attribute keywords recognized by the parser.
+***********************************************************************************************************************/
+
+/* .. sphinx-project inehtmlscrubber */
+
+#ifndef HTML_SCRUBBER_KEYWORD_MATCHER_H
+#define HTML_SCRUBBER_KEYWORD_MATCHER_H
+
+#include <cstdint>
+#include <cstring>
+
+#include "html_scrubber_parser.h"
+
+namespace HtmlScrubber {
+    /**
+     * Class that matches the keywords "script", "style", "src=", "href=", and "cite=" using a single 8 byte load.
+     *
+     * The parser recognizes each keyword one byte at a time through a chain of single character states.  When the
+     * parser is in a state where a keyword can begin and at least 8 bytes of lookahead are available, this class
+     * compares the whole keyword at once by folding the letter positions to lower case and masking off the bytes
+     * beyond the keyword.  On a match the caller can jump directly to the state the parser would reach after the
+     * final keyword byte.  No transition hooks fire on any of the skipped transitions.  On a mismatch, or when too
+     * little lookahead remains, the caller simply continues one byte at a time.
+     */
+    class KeywordMatcher {
+        private:
+            /**
+             * Structure describing a packed keyword.  Byte n of the keyword occupies bits 8n through 8n+7.
+             */
+            struct Keyword {
+                /**
+                 * The lower case keyword.
+                 */
+                std::uint64_t value;
+
+                /**
+                 * Mask of bits to set to fold letters to lower case.
+                 */
+                std::uint64_t fold;
+
+                /**
+                 * Mask selecting the bytes that make up the keyword.
+                 */
+                std::uint64_t mask;
+
+                /**
+                 * The keyword length, in bytes.
+                 */
+                unsigned long length;
+            };
+
+            /**
+             * Method that builds a packed keyword.
+             *
+             * \param[in] text      The lower case keyword.  Must be no longer than 8 bytes.
+             *
+             * \param[in] foldFirst If true, the first byte is matched without regard to case.  If false, the first
+             *                      byte must match exactly.
+             *
+             * \return Returns the packed keyword.
+             */
+            static constexpr Keyword keyword(const char* text, bool foldFirst) {
+                Keyword       result = { 0, 0, 0, 0 };
+                unsigned long i      = 0;
+
+                while (text[i] != '\0') {
+                    std::uint64_t byte = static_cast<std::uint8_t>(text[i]);
+
+                    result.value |= byte << (8 * i);
+                    result.mask  |= std::uint64_t(0xFF) << (8 * i);
+
+                    if (byte >= 'a' && byte <= 'z' && (foldFirst || i > 0)) {
+                        result.fold |= std::uint64_t(0x20) << (8 * i);
+                    }
+
+                    ++i;
+                }
+
+                result.length = i;
+                return result;
+            }
+
+        public:
+            /**
+             * Type used to represent parser states.
+             */
+            typedef Parser::States States;
+
+            /**
+             * The number of bytes of lookahead required to attempt a match.
+             */
+            static constexpr unsigned long lookahead = 8;
+
+            /**
+             * Method that attempts to match a keyword.
+             *
+             * \param[in]  state     The current parser state.
+             *
+             * \param[in]  data      Pointer to the next byte to be parsed.
+             *
+             * \param[in]  available The number of bytes available starting at data.
+             *
+             * \param[out] newState  The parser state after the keyword.  Only set on a match.
+             *
+             * \return Returns the number of bytes matched.  A value of 0 is returned if no keyword matched.
+             */
+            static inline unsigned long match(
+                    States        state,
+                    const char*   data,
+                    unsigned long available,
+                    States&       newState
+                ) {
+                constexpr Keyword script       = keyword("script", false);
+                constexpr Keyword style        = keyword("style", false);
+                constexpr Keyword closingStyle = keyword("style", true);
+                constexpr Keyword src          = keyword("src=", true);
+                constexpr Keyword href         = keyword("href=", true);
+                constexpr Keyword cite         = keyword("cite=", true);
+
+                unsigned long result = 0;
+
+                if (available >= lookahead) {
+                    switch (state) {
+                        case States::IN_TAG_START: {
+                            std::uint64_t word = load(data);
+
+                            if (matches(word, script)) {
+                                newState = States::IN_TAG_SCRIPT;
+                                result   = script.length;
+                            } else if (matches(word, style)) {
+                                newState = States::IN_TAG_STYLE;
+                                result   = style.length;
+                            }
+
+                            break;
+                        }
+
+                        case States::IN_TAG_SPACE: {
+                            std::uint64_t word = load(data);
+
+                            if (matches(word, src)) {
+                                newState = States::IN_TAG_SPACE_SRC_EQUALS;
+                                result   = src.length;
+                            } else if (matches(word, href)) {
+                                newState = States::IN_TAG_SPACE_HREF_EQUALS;
+                                result   = href.length;
+                            } else if (matches(word, cite)) {
+                                newState = States::IN_TAG_SPACE_CITE_EQUALS;
+                                result   = cite.length;
+                            }
+
+                            break;
+                        }
+
+                        case States::IN_TAG_SCRIPT_SPACE: {
+                            if (matches(load(data), src)) {
+                                newState = States::IN_TAG_SCRIPT_SPACE_SRC_EQUALS;
+                                result   = src.length;
+                            }
+
+                            break;
+                        }
+
+                        case States::IN_STYLE_TAG_SLASH: {
+                            if (matches(load(data), closingStyle)) {
+                                newState = States::IN_STYLE_TAG_SLASH_STYLE;
+                                result   = closingStyle.length;
+                            }
+
+                            break;
+                        }
+
+                        default: {
+                            break;
+                        }
+                    }
+                }
+
+                return result;
+            }
+
+        private:
+            /**
+             * Method that loads 8 bytes with the first byte in the least significant position.
+             *
+             * \param[in] data Pointer to the bytes to be loaded.
+             *
+             * \return Returns the packed bytes.
+             */
+            static inline std::uint64_t load(const char* data) {
+                std::uint64_t result;
+                std::memcpy(&result, data, sizeof(result));
+
+                #if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+                    result = __builtin_bswap64(result);
+                #endif
+
+                return result;
+            }
+
+            /**
+             * Method that compares packed bytes against a keyword.
+             *
+             * \param[in] word    The packed bytes.
+             *
+             * \param[in] keyword The keyword to compare against.
+             *
+             * \return Returns true if the keyword matches.  Returns false if the keyword does not match.
+             */
+            static inline bool matches(std::uint64_t word, const Keyword& keyword) {
+                return ((word | keyword.fold) & keyword.mask) == keyword.value;
+            }
+    };
+};
+#endif
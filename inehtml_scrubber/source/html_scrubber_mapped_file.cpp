@@ -0,0 +1,84 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the read-only memory mapping of a file.
+***********************************************************************************************************************/
+
+#include <QtGlobal>
+#include <QString>
+#include <QFile>
+
+#if (defined(Q_OS_UNIX))
+    #include <sys/mman.h>
+#endif
+
+#include "html_scrubber_mapped_file.h"
+
+namespace HtmlScrubber {
+    MappedFile::MappedFile(
+            const QString& filename
+        ):file(
+            filename
+        ), mappedData(
+            nullptr
+        ), mappedLength(
+            0
+        ), currentValid(
+            false
+        ) {
+        if (file.open(QFile::ReadOnly)) {
+            qint64 fileSize = file.size();
+
+            if (fileSize == 0) {
+                currentValid = true;
+            } else if (fileSize > 0) {
+                mappedData = file.map(0, fileSize);
+
+                if (mappedData != nullptr) {
+                    mappedLength = static_cast<unsigned long>(fileSize);
+                    currentValid = true;
+
+                    #if (defined(Q_OS_UNIX) && defined(MADV_SEQUENTIAL))
+                        madvise(mappedData, mappedLength, MADV_SEQUENTIAL);
+                    #endif
+                }
+            }
+        }
+    }
+
+
+    MappedFile::~MappedFile() {
+        if (mappedData != nullptr) {
+            file.unmap(mappedData);
+        }
+    }
+
+
+    bool MappedFile::isValid() const {
+        return currentValid;
+    }
+
+
+    const char* MappedFile::data() const {
+        return mappedData != nullptr ? reinterpret_cast<const char*>(mappedData) : "";
+    }
+
+
+    unsigned long MappedFile::size() const {
+        return mappedLength;
+    }
+}
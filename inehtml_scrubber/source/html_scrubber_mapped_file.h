@@ -0,0 +1,93 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides a read-only memory mapping of a file.
+***********************************************************************************************************************/
+
+/* .. sphinx-project inehtmlscrubber */
+
+#ifndef HTML_SCRUBBER_MAPPED_FILE_H
+#define HTML_SCRUBBER_MAPPED_FILE_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QFile>
+
+namespace HtmlScrubber {
+    /**
+     * Class that maps a file into memory, read-only, for the lifetime of the instance.  On platforms that support it,
+     * the kernel is advised that the mapping will be read sequentially so that read-ahead is aggressive and pages can
+     * be dropped soon after they are scanned.
+     *
+     * The mapping ends exactly at the end of the file and can not be extended, so the contents must be scrubbed using
+     * \ref HtmlScrubber::Engine::InputMode::READ_ONLY.
+     */
+    class MappedFile {
+        public:
+            /**
+             * Constructor
+             *
+             * \param[in] filename The name of the file to be mapped.
+             */
+            MappedFile(const QString& filename);
+
+            ~MappedFile();
+
+            /**
+             * Method you can use to determine if the file was mapped.
+             *
+             * \return Returns true if the file was opened and mapped.  Returns false on error.
+             */
+            bool isValid() const;
+
+            /**
+             * Method you can use to obtain the mapped contents.
+             *
+             * \return Returns a pointer to the start of the file.  A valid pointer is returned for empty files.
+             */
+            const char* data() const;
+
+            /**
+             * Method you can use to obtain the size of the mapping.
+             *
+             * \return Returns the length of the file, in bytes.
+             */
+            unsigned long size() const;
+
+        private:
+            /**
+             * The mapped file.
+             */
+            QFile file;
+
+            /**
+             * Pointer to the mapping.  The pointer is null if the file could not be mapped or is empty.
+             */
+            uchar* mappedData;
+
+            /**
+             * The length of the mapping, in bytes.
+             */
+            unsigned long mappedLength;
+
+            /**
+             * Flag indicating if the file was mapped.
+             */
+            bool currentValid;
+    };
+};
+#endif
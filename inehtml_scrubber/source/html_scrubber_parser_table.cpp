@@ -0,0 +1,458 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file builds the compile-time parser transition table.
+***********************************************************************************************************************/
+
+#include <cstdint>
+
+#include "html_scrubber_parser.h"
+#include "html_scrubber_parser_table.h"
+
+namespace HtmlScrubber {
+    namespace {
+        typedef ParserTable::States     States;
+        typedef ParserTable::Hook       Hook;
+        typedef ParserTable::Transition Transition;
+
+        constexpr bool isSpace(char c) {
+            return c == ' ' || (c >= '\t' && c <= '\r');
+        }
+
+        constexpr bool isLetter(char c, char lowerCase) {
+            return c == lowerCase || c == lowerCase - ('a' - 'A');
+        }
+
+        constexpr Transition to(States newState, Hook hook = Hook::NONE) {
+            return Transition { static_cast<std::uint8_t>(newState), hook };
+        }
+    }
+
+    constexpr ParserTable::ByteClass ParserTable::classify(char c) {
+        return   isSpace(c)       ? ByteClass::WHITESPACE
+               : c == '<'         ? ByteClass::LESS_THAN
+               : c == '>'         ? ByteClass::GREATER_THAN
+               : c == '/'         ? ByteClass::SLASH
+               : c == '='         ? ByteClass::EQUALS
+               : c == '"'         ? ByteClass::DOUBLE_QUOTE
+               : c == '\''        ? ByteClass::SINGLE_QUOTE
+               : c == '?'         ? ByteClass::QUESTION_MARK
+               : c == 's'         ? ByteClass::LOWER_S
+               : c == 'S'         ? ByteClass::UPPER_S
+               : isLetter(c, 'r') ? ByteClass::LETTER_R
+               : isLetter(c, 'c') ? ByteClass::LETTER_C
+               : isLetter(c, 'h') ? ByteClass::LETTER_H
+               : isLetter(c, 'e') ? ByteClass::LETTER_E
+               : isLetter(c, 'f') ? ByteClass::LETTER_F
+               : isLetter(c, 'i') ? ByteClass::LETTER_I
+               : isLetter(c, 't') ? ByteClass::LETTER_T
+               : isLetter(c, 'p') ? ByteClass::LETTER_P
+               : isLetter(c, 'y') ? ByteClass::LETTER_Y
+               : isLetter(c, 'l') ? ByteClass::LETTER_L
+               :                    ByteClass::OTHER;
+    }
+
+
+    constexpr char ParserTable::representative(ParserTable::ByteClass byteClass) {
+        constexpr char representatives[] = {
+            'x', ' ', '<', '>', '/', '=', '"', '\'', '?', 's', 'S', 'r', 'c', 'h', 'e', 'f', 'i', 't', 'p', 'y', 'l'
+        };
+
+        static_assert(
+            sizeof(representatives) == static_cast<unsigned>(ByteClass::NUMBER_BYTE_CLASSES),
+            "Missing byte class representative."
+        );
+
+        return representatives[static_cast<unsigned>(byteClass)];
+    }
+
+
+    constexpr ParserTable::Transition ParserTable::nextTransition(ParserTable::States state, char c) {
+        switch (state) {
+            case States::IN_TEXT_SPACE: {
+                return   c == '<'   ? to(States::IN_TAG_START, Hook::START_TAG)
+                       : isSpace(c) ? to(States::IN_TEXT_MULTIPLE_SPACE, Hook::MULTIPLE_WHITE_SPACE)
+                       :              to(States::IN_TEXT, Hook::RESUME_TEXT);
+            }
+
+            case States::IN_TEXT_MULTIPLE_SPACE: {
+                return   c == '<'   ? to(States::IN_TAG_START, Hook::START_TAG)
+                       : isSpace(c) ? to(States::IN_TEXT_MULTIPLE_SPACE)
+                       :              to(States::IN_TEXT, Hook::RESUME_TEXT);
+            }
+
+            case States::IN_TEXT: {
+                return   c == '<'   ? to(States::IN_TAG_START, Hook::START_TAG)
+                       : isSpace(c) ? to(States::IN_TEXT_SPACE, Hook::WHITESPACE)
+                       :              to(States::IN_TEXT);
+            }
+
+            case States::IN_TAG_START: {
+                return   c == '/' ? to(States::IN_TAG_SLASH)
+                       : c == 's' ? to(States::IN_TAG_S)
+                       :            to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SEARCH: {
+                return   c == '>'   ? to(States::IN_TEXT_SPACE, Hook::END_TAG)
+                       : isSpace(c) ? to(States::IN_TAG_SPACE)
+                       : c == '"'   ? to(States::IN_TAG_QUOTE)
+                       :              to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_QUOTE: {
+                return c == '"' ? to(States::IN_TAG_SEARCH) : to(States::IN_TAG_QUOTE);
+            }
+
+            case States::IN_TAG_SPACE: {
+                return   c == '>'         ? to(States::IN_TEXT_SPACE, Hook::END_TAG)
+                       : isLetter(c, 's') ? to(States::IN_TAG_SPACE_S)
+                       : isLetter(c, 'h') ? to(States::IN_TAG_SPACE_H)
+                       : isLetter(c, 'c') ? to(States::IN_TAG_SPACE_C)
+                       : !isSpace(c)      ? to(States::IN_TAG_SEARCH)
+                       :                    to(States::IN_TAG_SPACE);
+            }
+
+            case States::IN_TAG_SLASH: {
+                return c == '>' ? to(States::IN_TEXT_SPACE) : to(States::IN_TAG_SLASH);
+            }
+
+            case States::IN_TAG_SPACE_S: {
+                return   c == '>'         ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isLetter(c, 'r') ? to(States::IN_TAG_SPACE_SR)
+                       :                    to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SPACE_SR: {
+                return   c == '>'         ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isLetter(c, 'c') ? to(States::IN_TAG_SPACE_SRC)
+                       :                    to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SPACE_SRC: {
+                return   c == '>'   ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isSpace(c) ? to(States::IN_TAG_SPACE_SRC)
+                       : c == '='   ? to(States::IN_TAG_SPACE_SRC_EQUALS)
+                       :              to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SPACE_SRC_EQUALS: {
+                return   c == '>'              ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isSpace(c)            ? to(States::IN_TAG_SPACE_SRC_EQUALS)
+                       : c == '"' || c == '\'' ? to(States::IN_TAG_SPACE_SRC_EQUALS_QUOTE, Hook::START_SRC_ATTRIBUTE)
+                       :                         to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SPACE_SRC_EQUALS_QUOTE: {
+                return   c == '"' || c == '\'' ? to(States::IN_TAG_SEARCH, Hook::END_SRC_ATTRIBUTE)
+                       : c == '?'              ? to(States::IN_TAG_SPACE_SRC_EQUALS_QUOTE_QM, Hook::END_SRC_ATTRIBUTE)
+                       :                         to(States::IN_TAG_SPACE_SRC_EQUALS_QUOTE);
+            }
+
+            case States::IN_TAG_SPACE_SRC_EQUALS_QUOTE_QM: {
+                return   c == '"' || c == '\'' ? to(States::IN_TAG_SEARCH)
+                       :                         to(States::IN_TAG_SPACE_SRC_EQUALS_QUOTE_QM);
+            }
+
+            case States::IN_TAG_SPACE_H: {
+                return   c == '>'         ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isLetter(c, 'r') ? to(States::IN_TAG_SPACE_HR)
+                       :                    to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SPACE_HR: {
+                return   c == '>'         ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isLetter(c, 'e') ? to(States::IN_TAG_SPACE_HRE)
+                       :                    to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SPACE_HRE: {
+                return   c == '>'         ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isLetter(c, 'f') ? to(States::IN_TAG_SPACE_HREF)
+                       :                    to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SPACE_HREF: {
+                return   c == '>'   ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isSpace(c) ? to(States::IN_TAG_SPACE_HREF)
+                       : c == '='   ? to(States::IN_TAG_SPACE_HREF_EQUALS)
+                       :              to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SPACE_HREF_EQUALS: {
+                return   c == '>'              ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isSpace(c)            ? to(States::IN_TAG_SPACE_HREF_EQUALS)
+                       : c == '"' || c == '\'' ? to(States::IN_TAG_SPACE_HREF_EQUALS_QUOTE, Hook::START_HREF_ATTRIBUTE)
+                       :                         to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SPACE_HREF_EQUALS_QUOTE: {
+                return   c == '"' || c == '\'' ? to(States::IN_TAG_SEARCH, Hook::END_HREF_ATTRIBUTE)
+                       :                         to(States::IN_TAG_SPACE_HREF_EQUALS_QUOTE);
+            }
+
+            case States::IN_TAG_SPACE_C: {
+                return   c == '>'         ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isLetter(c, 'i') ? to(States::IN_TAG_SPACE_CI)
+                       :                    to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SPACE_CI: {
+                return   c == '>'         ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isLetter(c, 't') ? to(States::IN_TAG_SPACE_CIT)
+                       :                    to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SPACE_CIT: {
+                return   c == '>'         ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isLetter(c, 'e') ? to(States::IN_TAG_SPACE_CITE)
+                       :                    to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SPACE_CITE: {
+                return   c == '>'   ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isSpace(c) ? to(States::IN_TAG_SPACE_CITE)
+                       : c == '='   ? to(States::IN_TAG_SPACE_CITE_EQUALS)
+                       :              to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SPACE_CITE_EQUALS: {
+                return   c == '>'              ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isSpace(c)            ? to(States::IN_TAG_SPACE_CITE_EQUALS)
+                       : c == '"' || c == '\'' ? to(States::IN_TAG_SPACE_CITE_EQUALS_QUOTE, Hook::START_CITE_ATTRIBUTE)
+                       :                         to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SPACE_CITE_EQUALS_QUOTE: {
+                return   c == '"' || c == '\'' ? to(States::IN_TAG_SEARCH, Hook::END_CITE_ATTRIBUTE)
+                       :                         to(States::IN_TAG_SPACE_CITE_EQUALS_QUOTE);
+            }
+
+            case States::IN_TAG_S: {
+                return   c == '>'         ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isLetter(c, 'c') ? to(States::IN_TAG_SC)
+                       : isLetter(c, 't') ? to(States::IN_TAG_ST)
+                       : isSpace(c)       ? to(States::IN_TAG_SPACE)
+                       :                    to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SC: {
+                return   c == '>'         ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isLetter(c, 'r') ? to(States::IN_TAG_SCR)
+                       : isSpace(c)       ? to(States::IN_TAG_SPACE)
+                       :                    to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SCR: {
+                return   c == '>'         ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isLetter(c, 'i') ? to(States::IN_TAG_SCRI)
+                       : isSpace(c)       ? to(States::IN_TAG_SPACE)
+                       :                    to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SCRI: {
+                return   c == '>'         ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isLetter(c, 'p') ? to(States::IN_TAG_SCRIP)
+                       : isSpace(c)       ? to(States::IN_TAG_SPACE)
+                       :                    to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SCRIP: {
+                return   c == '>'         ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isLetter(c, 't') ? to(States::IN_TAG_SCRIPT)
+                       : isSpace(c)       ? to(States::IN_TAG_SPACE)
+                       :                    to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SCRIPT: {
+                return   c == '>'   ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isSpace(c) ? to(States::IN_TAG_SCRIPT_SPACE)
+                       :              to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SCRIPT_SPACE: {
+                return   c == '>'         ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isSpace(c)       ? to(States::IN_TAG_SCRIPT_SPACE)
+                       : isLetter(c, 's') ? to(States::IN_TAG_SCRIPT_SPACE_S)
+                       :                    to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SCRIPT_SPACE_S: {
+                return   c == '>'         ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isSpace(c)       ? to(States::IN_TAG_SCRIPT_SPACE)
+                       : isLetter(c, 'r') ? to(States::IN_TAG_SCRIPT_SPACE_SR)
+                       :                    to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SCRIPT_SPACE_SR: {
+                return   c == '>'         ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isSpace(c)       ? to(States::IN_TAG_SCRIPT_SPACE)
+                       : isLetter(c, 'c') ? to(States::IN_TAG_SCRIPT_SPACE_SRC)
+                       :                    to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SCRIPT_SPACE_SRC: {
+                return   c == '>'   ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isSpace(c) ? to(States::IN_TAG_SCRIPT_SPACE_SRC)
+                       : c == '='   ? to(States::IN_TAG_SCRIPT_SPACE_SRC_EQUALS)
+                       :              to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SCRIPT_SPACE_SRC_EQUALS: {
+                return   c == '>'              ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isSpace(c)            ? to(States::IN_TAG_SCRIPT_SPACE_SRC_EQUALS)
+                       : c == '"' || c == '\'' ? to(
+                                                     States::IN_TAG_SCRIPT_SPACE_SRC_EQUALS_QUOTE,
+                                                     Hook::START_SCRIPT_SRC_ATTRIBUTE
+                                                 )
+                       :                         to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_SCRIPT_SPACE_SRC_EQUALS_QUOTE: {
+                return   c == '"' || c == '\'' ? to(States::IN_TEXT_SPACE, Hook::END_SCRIPT_SRC_ATTRIBUTE)
+                       :                         to(States::IN_TAG_SCRIPT_SPACE_SRC_EQUALS_QUOTE);
+            }
+
+            case States::IN_TAG_ST: {
+                return   c == '>'         ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isLetter(c, 'y') ? to(States::IN_TAG_STY)
+                       : isSpace(c)       ? to(States::IN_TAG_SPACE)
+                       :                    to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_STY: {
+                return   c == '>'         ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isLetter(c, 'l') ? to(States::IN_TAG_STYL)
+                       : isSpace(c)       ? to(States::IN_TAG_SPACE)
+                       :                    to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_STYL: {
+                return   c == '>'         ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isLetter(c, 'e') ? to(States::IN_TAG_STYLE)
+                       : isSpace(c)       ? to(States::IN_TAG_SPACE)
+                       :                    to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_STYLE: {
+                return   c == '>'   ? to(States::IN_STYLE_START)
+                       : c == '/'   ? to(States::IN_TAG_STYLE_SLASH)
+                       : isSpace(c) ? to(States::IN_TAG_STYLE_SPACE)
+                       :              to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_STYLE_SLASH: {
+                return   c == '>'   ? to(States::IN_TEXT_SPACE, Hook::RESUME_TEXT)
+                       : isSpace(c) ? to(States::IN_TAG_STYLE_SLASH)
+                       :              to(States::IN_TAG_SEARCH);
+            }
+
+            case States::IN_TAG_STYLE_SPACE: {
+                return c == '>' ? to(States::IN_STYLE_START) : to(States::IN_TAG_STYLE_SEARCH);
+            }
+
+            case States::IN_TAG_STYLE_SEARCH: {
+                return   c == '>'              ? to(States::IN_STYLE_START)
+                       : c == '"' || c == '\'' ? to(States::IN_TAG_STYLE_QUOTE)
+                       : c == '/'              ? to(States::IN_TAG_STYLE_SLASH)
+                       :                         to(States::IN_TAG_STYLE_SEARCH);
+            }
+
+            case States::IN_TAG_STYLE_QUOTE: {
+                return   c == '"' || c == '\'' ? to(States::IN_TAG_STYLE_SEARCH)
+                       :                         to(States::IN_TAG_STYLE_QUOTE);
+            }
+
+            case States::IN_STYLE_START: {
+                return c == '<' ? to(States::IN_TAG_START) : to(States::IN_STYLE, Hook::START_STYLE);
+            }
+
+            case States::IN_STYLE: {
+                return c == '<' ? to(States::IN_STYLE_TAG_START) : to(States::IN_STYLE);
+            }
+
+            case States::IN_STYLE_TAG_START: {
+                return   c == '/'   ? to(States::IN_STYLE_TAG_SLASH)
+                       : isSpace(c) ? to(States::IN_STYLE_TAG_START)
+                       :              to(States::IN_STYLE);
+            }
+
+            case States::IN_STYLE_TAG_SLASH: {
+                return   isLetter(c, 's') ? to(States::IN_STYLE_TAG_SLASH_S)
+                       : isSpace(c)       ? to(States::IN_STYLE_TAG_SLASH)
+                       :                    to(States::IN_STYLE);
+            }
+
+            case States::IN_STYLE_TAG_SLASH_S: {
+                return isLetter(c, 't') ? to(States::IN_STYLE_TAG_SLASH_ST) : to(States::IN_STYLE);
+            }
+
+            case States::IN_STYLE_TAG_SLASH_ST: {
+                return isLetter(c, 'y') ? to(States::IN_STYLE_TAG_SLASH_STY) : to(States::IN_STYLE);
+            }
+
+            case States::IN_STYLE_TAG_SLASH_STY: {
+                return isLetter(c, 'l') ? to(States::IN_STYLE_TAG_SLASH_STYL) : to(States::IN_STYLE);
+            }
+
+            case States::IN_STYLE_TAG_SLASH_STYL: {
+                return isLetter(c, 'e') ? to(States::IN_STYLE_TAG_SLASH_STYLE) : to(States::IN_STYLE);
+            }
+
+            case States::IN_STYLE_TAG_SLASH_STYLE: {
+                return   c == '>'   ? to(States::IN_TEXT_SPACE, Hook::END_STYLE)
+                       : isSpace(c) ? to(States::IN_STYLE_TAG_SLASH_STYLE)
+                       :              to(States::IN_STYLE);
+            }
+
+            default: {
+                return to(state);
+            }
+        }
+    }
+
+
+    constexpr ParserTable::ByteClassTable ParserTable::buildByteClasses() {
+        ByteClassTable result {};
+
+        for (unsigned value=0 ; value<256 ; ++value) {
+            result.entries[value] = classify(static_cast<char>(value));
+        }
+
+        return result;
+    }
+
+
+    constexpr ParserTable::TransitionTable ParserTable::buildTransitions() {
+        TransitionTable result {};
+
+        for (unsigned state=0 ; state<numberStates ; ++state) {
+            for (unsigned byteClass=0 ; byteClass<numberByteClasses ; ++byteClass) {
+                result.entries[state][byteClass] = nextTransition(
+                    static_cast<States>(state),
+                    representative(static_cast<ByteClass>(byteClass))
+                );
+            }
+        }
+
+        return result;
+    }
+
+
+    constexpr ParserTable::ByteClassTable  ParserTable::byteClasses = ParserTable::buildByteClasses();
+    constexpr ParserTable::TransitionTable ParserTable::transitions = ParserTable::buildTransitions();
+}
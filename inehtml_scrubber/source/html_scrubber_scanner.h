@@ -0,0 +1,423 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides vectorized helpers used to skip over long runs of bytes that can not change the parser state.
+***********************************************************************************************************************/
+
+/* .. sphinx-project inehtmlscrubber */
+
+#ifndef HTML_SCRUBBER_SCANNER_H
+#define HTML_SCRUBBER_SCANNER_H
+
+#include <cstdint>
+
+#if (defined(__AVX2__))
+    #include <immintrin.h>
+#elif (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define HTML_SCRUBBER_SSE2
+#endif
+
+#if (defined(_MSC_VER))
+    #include <intrin.h>
+#endif
+
+#include "html_scrubber_parser.h"
+
+namespace HtmlScrubber {
+    /**
+     * Class that locates the next byte that can cause a parser transition.
+     *
+     * Many parser states only leave the state, or fire a transition hook, on a handful of delimiter bytes.  While in
+     * one of those states, every byte up to the next delimiter can be consumed in bulk.  Bytes with the high bit set
+     * are always treated as delimiters so that the caller can apply its UTF-8 handling to them.
+     *
+     * SSE2 is used when available and AVX2 is used when the library is built with AVX2 enabled.  A scalar fallback
+     * is used on other targets.
+     */
+    class Scanner {
+        public:
+            /**
+             * Type used to represent parser states.
+             */
+            typedef Parser::States States;
+
+            /**
+             * Enumeration of delimiter sets.
+             */
+            enum class DelimiterSet : std::uint8_t {
+                /**
+                 * Indicates that every byte can cause a transition.
+                 */
+                NONE,
+
+                /**
+                 * Indicates text content, delimited by '<' or whitespace.
+                 */
+                TEXT,
+
+                /**
+                 * Indicates a run of whitespace, delimited by any non-whitespace byte.
+                 */
+                WHITESPACE_RUN,
+
+                /**
+                 * Indicates the body of a tag, delimited by '>', '"', or whitespace.
+                 */
+                TAG_SEARCH,
+
+                /**
+                 * Indicates a double quoted string within a tag, delimited by '"'.
+                 */
+                TAG_QUOTE,
+
+                /**
+                 * Indicates a quoted attribute value, delimited by '"' or '\''.
+                 */
+                QUOTE,
+
+                /**
+                 * Indicates a quoted src attribute value, delimited by '"', '\'', or '?'.
+                 */
+                SRC_QUOTE,
+
+                /**
+                 * Indicates a closing tag, delimited by '>'.
+                 */
+                TAG_SLASH,
+
+                /**
+                 * Indicates the body of a style tag, delimited by '>', '"', '\'', or '/'.
+                 */
+                STYLE_SEARCH,
+
+                /**
+                 * Indicates style content, delimited by '<'.
+                 */
+                STYLE
+            };
+
+            /**
+             * Method that determines the delimiter set for a parser state.
+             *
+             * \param[in] state The parser state.
+             *
+             * \return Returns the delimiter set for the state.
+             */
+            static inline DelimiterSet delimiterSet(States state) {
+                static const DelimiterSet delimiterSets[] = {
+                    DelimiterSet::NONE,           // IN_TEXT_SPACE
+                    DelimiterSet::WHITESPACE_RUN, // IN_TEXT_MULTIPLE_SPACE
+                    DelimiterSet::TEXT,           // IN_TEXT
+                    DelimiterSet::NONE,           // IN_TAG_START
+                    DelimiterSet::TAG_SEARCH,     // IN_TAG_SEARCH
+                    DelimiterSet::TAG_QUOTE,      // IN_TAG_QUOTE
+                    DelimiterSet::NONE,           // IN_TAG_SPACE
+                    DelimiterSet::TAG_SLASH,      // IN_TAG_SLASH
+                    DelimiterSet::NONE,           // IN_TAG_SPACE_S
+                    DelimiterSet::NONE,           // IN_TAG_SPACE_SR
+                    DelimiterSet::NONE,           // IN_TAG_SPACE_SRC
+                    DelimiterSet::NONE,           // IN_TAG_SPACE_SRC_EQUALS
+                    DelimiterSet::SRC_QUOTE,      // IN_TAG_SPACE_SRC_EQUALS_QUOTE
+                    DelimiterSet::QUOTE,          // IN_TAG_SPACE_SRC_EQUALS_QUOTE_QM
+                    DelimiterSet::NONE,           // IN_TAG_SPACE_H
+                    DelimiterSet::NONE,           // IN_TAG_SPACE_HR
+                    DelimiterSet::NONE,           // IN_TAG_SPACE_HRE
+                    DelimiterSet::NONE,           // IN_TAG_SPACE_HREF
+                    DelimiterSet::NONE,           // IN_TAG_SPACE_HREF_EQUALS
+                    DelimiterSet::QUOTE,          // IN_TAG_SPACE_HREF_EQUALS_QUOTE
+                    DelimiterSet::NONE,           // IN_TAG_SPACE_C
+                    DelimiterSet::NONE,           // IN_TAG_SPACE_CI
+                    DelimiterSet::NONE,           // IN_TAG_SPACE_CIT
+                    DelimiterSet::NONE,           // IN_TAG_SPACE_CITE
+                    DelimiterSet::NONE,           // IN_TAG_SPACE_CITE_EQUALS
+                    DelimiterSet::QUOTE,          // IN_TAG_SPACE_CITE_EQUALS_QUOTE
+                    DelimiterSet::NONE,           // IN_TAG_S
+                    DelimiterSet::NONE,           // IN_TAG_SC
+                    DelimiterSet::NONE,           // IN_TAG_SCR
+                    DelimiterSet::NONE,           // IN_TAG_SCRI
+                    DelimiterSet::NONE,           // IN_TAG_SCRIP
+                    DelimiterSet::NONE,           // IN_TAG_SCRIPT
+                    DelimiterSet::NONE,           // IN_TAG_SCRIPT_SPACE
+                    DelimiterSet::NONE,           // IN_TAG_SCRIPT_SPACE_S
+                    DelimiterSet::NONE,           // IN_TAG_SCRIPT_SPACE_SR
+                    DelimiterSet::NONE,           // IN_TAG_SCRIPT_SPACE_SRC
+                    DelimiterSet::NONE,           // IN_TAG_SCRIPT_SPACE_SRC_EQUALS
+                    DelimiterSet::QUOTE,          // IN_TAG_SCRIPT_SPACE_SRC_EQUALS_QUOTE
+                    DelimiterSet::NONE,           // IN_TAG_ST
+                    DelimiterSet::NONE,           // IN_TAG_STY
+                    DelimiterSet::NONE,           // IN_TAG_STYL
+                    DelimiterSet::NONE,           // IN_TAG_STYLE
+                    DelimiterSet::NONE,           // IN_TAG_STYLE_SLASH
+                    DelimiterSet::NONE,           // IN_TAG_STYLE_SPACE
+                    DelimiterSet::STYLE_SEARCH,   // IN_TAG_STYLE_SEARCH
+                    DelimiterSet::QUOTE,          // IN_TAG_STYLE_QUOTE
+                    DelimiterSet::NONE,           // IN_STYLE_START
+                    DelimiterSet::STYLE,          // IN_STYLE
+                    DelimiterSet::NONE,           // IN_STYLE_TAG_START
+                    DelimiterSet::NONE,           // IN_STYLE_TAG_SLASH
+                    DelimiterSet::NONE,           // IN_STYLE_TAG_SLASH_S
+                    DelimiterSet::NONE,           // IN_STYLE_TAG_SLASH_ST
+                    DelimiterSet::NONE,           // IN_STYLE_TAG_SLASH_STY
+                    DelimiterSet::NONE,           // IN_STYLE_TAG_SLASH_STYL
+                    DelimiterSet::NONE            // IN_STYLE_TAG_SLASH_STYLE
+                };
+
+                static_assert(
+                    sizeof(delimiterSets) == static_cast<unsigned>(States::NUMBER_STATES),
+                    "Delimiter set table does not match the parser states."
+                );
+
+                return delimiterSets[static_cast<unsigned>(state)];
+            }
+
+            /**
+             * Method that counts the bytes that can be consumed without causing a transition.
+             *
+             * \param[in] delimiters The delimiter set for the current parser state.
+             *
+             * \param[in] data       Pointer to the first byte to be examined.
+             *
+             * \param[in] length     The number of bytes available.
+             *
+             * \return Returns the number of bytes preceding the first delimiter.  The value will equal length if no
+             *         delimiter was found.
+             */
+            static inline unsigned long skip(DelimiterSet delimiters, const char* data, unsigned long length) {
+                unsigned long result;
+
+                switch (delimiters) {
+                    case DelimiterSet::NONE: {
+                        result = 0;
+                        break;
+                    }
+
+                    case DelimiterSet::TEXT: {
+                        result = find<'<', '<', '<', '<', true, false>(data, length);
+                        break;
+                    }
+
+                    case DelimiterSet::WHITESPACE_RUN: {
+                        result = find<0, 0, 0, 0, true, true>(data, length);
+                        break;
+                    }
+
+                    case DelimiterSet::TAG_SEARCH: {
+                        result = find<'>', '"', '"', '"', true, false>(data, length);
+                        break;
+                    }
+
+                    case DelimiterSet::TAG_QUOTE: {
+                        result = find<'"', '"', '"', '"', false, false>(data, length);
+                        break;
+                    }
+
+                    case DelimiterSet::QUOTE: {
+                        result = find<'"', '\'', '"', '"', false, false>(data, length);
+                        break;
+                    }
+
+                    case DelimiterSet::SRC_QUOTE: {
+                        result = find<'"', '\'', '?', '"', false, false>(data, length);
+                        break;
+                    }
+
+                    case DelimiterSet::TAG_SLASH: {
+                        result = find<'>', '>', '>', '>', false, false>(data, length);
+                        break;
+                    }
+
+                    case DelimiterSet::STYLE_SEARCH: {
+                        result = find<'>', '"', '\'', '/', false, false>(data, length);
+                        break;
+                    }
+
+                    case DelimiterSet::STYLE: {
+                        result = find<'<', '<', '<', '<', false, false>(data, length);
+                        break;
+                    }
+
+                    default: {
+                        result = 0;
+                        break;
+                    }
+                }
+
+                return result;
+            }
+
+        private:
+            /**
+             * Method that determines if a byte is a whitespace character under the "C" locale.
+             *
+             * \param[in] c The byte to be tested.
+             *
+             * \return Returns true if the byte is whitespace.
+             */
+            static inline bool isSpace(char c) {
+                return c == ' ' || (c >= '\t' && c <= '\r');
+            }
+
+            /**
+             * Method that determines if a byte is a delimiter.
+             *
+             * \param[in] c The byte to be tested.
+             *
+             * \return Returns true if the byte is a delimiter.
+             */
+            template<char n0, char n1, char n2, char n3, bool whitespace, bool invert> static inline bool isDelimiter(
+                    char c
+                ) {
+                bool result;
+
+                if (invert) {
+                    result = !isSpace(c);
+                } else {
+                    result = (
+                           (c & 0x80) != 0
+                        || c == n0
+                        || c == n1
+                        || c == n2
+                        || c == n3
+                        || (whitespace && isSpace(c))
+                    );
+                }
+
+                return result;
+            }
+
+            /**
+             * Method that returns the index of the lowest set bit.
+             *
+             * \param[in] mask The mask to be tested.  The value must be non-zero.
+             *
+             * \return Returns the zero based index of the lowest set bit.
+             */
+            static inline unsigned lowestSetBit(std::uint32_t mask) {
+                #if (defined(_MSC_VER))
+                    unsigned long index;
+                    _BitScanForward(&index, mask);
+                    return static_cast<unsigned>(index);
+                #else
+                    return static_cast<unsigned>(__builtin_ctz(mask));
+                #endif
+            }
+
+            /**
+             * Method that locates the first delimiter.  Delimiters are the bytes n0 through n3, whitespace if
+             * whitespace is true, and any byte with the high bit set.  If invert is true, only non-whitespace bytes
+             * are delimiters.
+             *
+             * \param[in] data   Pointer to the first byte to be examined.
+             *
+             * \param[in] length The number of bytes available.
+             *
+             * \return Returns the number of bytes preceding the first delimiter.
+             */
+            template<char n0, char n1, char n2, char n3, bool whitespace, bool invert> static unsigned long find(
+                    const char*   data,
+                    unsigned long length
+                ) {
+                unsigned long index = 0;
+
+                #if (defined(__AVX2__))
+                    const __m256i v0    = _mm256_set1_epi8(n0);
+                    const __m256i v1    = _mm256_set1_epi8(n1);
+                    const __m256i v2    = _mm256_set1_epi8(n2);
+                    const __m256i v3    = _mm256_set1_epi8(n3);
+                    const __m256i space = _mm256_set1_epi8(' ');
+                    const __m256i tab   = _mm256_set1_epi8('\t' - 1);
+                    const __m256i cr    = _mm256_set1_epi8('\r' + 1);
+
+                    while (index + 32 <= length) {
+                        __m256i  x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index));
+                        __m256i  s = _mm256_or_si256(
+                            _mm256_cmpeq_epi8(x, space),
+                            _mm256_and_si256(_mm256_cmpgt_epi8(x, tab), _mm256_cmpgt_epi8(cr, x))
+                        );
+                        std::uint32_t mask;
+
+                        if (invert) {
+                            mask = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(s));
+                        } else {
+                            __m256i m = _mm256_or_si256(
+                                _mm256_or_si256(_mm256_cmpeq_epi8(x, v0), _mm256_cmpeq_epi8(x, v1)),
+                                _mm256_or_si256(_mm256_cmpeq_epi8(x, v2), _mm256_cmpeq_epi8(x, v3))
+                            );
+
+                            if (whitespace) {
+                                m = _mm256_or_si256(m, s);
+                            }
+
+                            mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(m, x)));
+                        }
+
+                        if (mask != 0) {
+                            return index + lowestSetBit(mask);
+                        }
+
+                        index += 32;
+                    }
+                #elif (defined(HTML_SCRUBBER_SSE2))
+                    const __m128i v0    = _mm_set1_epi8(n0);
+                    const __m128i v1    = _mm_set1_epi8(n1);
+                    const __m128i v2    = _mm_set1_epi8(n2);
+                    const __m128i v3    = _mm_set1_epi8(n3);
+                    const __m128i space = _mm_set1_epi8(' ');
+                    const __m128i tab   = _mm_set1_epi8('\t' - 1);
+                    const __m128i cr    = _mm_set1_epi8('\r' + 1);
+
+                    while (index + 16 <= length) {
+                        __m128i  x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+                        __m128i  s = _mm_or_si128(
+                            _mm_cmpeq_epi8(x, space),
+                            _mm_and_si128(_mm_cmpgt_epi8(x, tab), _mm_cmplt_epi8(x, cr))
+                        );
+                        std::uint32_t mask;
+
+                        if (invert) {
+                            mask = ~static_cast<std::uint32_t>(_mm_movemask_epi8(s)) & 0xFFFF;
+                        } else {
+                            __m128i m = _mm_or_si128(
+                                _mm_or_si128(_mm_cmpeq_epi8(x, v0), _mm_cmpeq_epi8(x, v1)),
+                                _mm_or_si128(_mm_cmpeq_epi8(x, v2), _mm_cmpeq_epi8(x, v3))
+                            );
+
+                            if (whitespace) {
+                                m = _mm_or_si128(m, s);
+                            }
+
+                            mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_or_si128(m, x)));
+                        }
+
+                        if (mask != 0) {
+                            return index + lowestSetBit(mask);
+                        }
+
+                        index += 16;
+                    }
+                #endif
+
+                while (index < length && !isDelimiter<n0, n1, n2, n3, whitespace, invert>(data[index])) {
+                    ++index;
+                }
+
+                return index;
+            }
+    };
+};
+#endif
@@ -23,37 +23,258 @@
 #include <QString>
 
 #include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <vector>
 
+#include "html_scrubber_utf8.h"
 #include "html_scrubber_engine.h"
+#include "html_scrubber_span_sink.h"
 #include "html_scrubber_scrubber.h"
 
 namespace HtmlScrubber {
-    Scrubber::Scrubber(const QByteArray& rawData):Engine(rawData) {}
+    namespace {
+        /*
+         * Function that empties a byte array without releasing its buffer.  Qt 5 releases the buffer when an array is
+         * resized to zero unless capacity has been reserved, so the existing capacity is reserved first.
+         */
+        void discardContents(QByteArray& array) {
+            if (array.capacity() > 0) {
+                array.reserve(array.capacity());
+            }
+
+            array.truncate(0);
+        }
+    }
+
+    Scrubber::Scrubber():Engine(
+            nullptr,
+            0
+        ), currentOutputMode(
+            OutputMode::MATERIALIZED
+        ), recordingSpans(
+            false
+        ), outputMaterialized(
+            true
+        ), outputPointer(
+            nullptr
+        ), outputLength(
+            0
+        ) {}
+
+
+    Scrubber::Scrubber(
+            const QByteArray&   rawData,
+            Scrubber::InputMode inputMode
+        ):Engine(
+            rawData.constData(),
+            static_cast<unsigned long>(rawData.size()),
+            inputMode
+        ), inputData(
+            rawData
+        ), currentOutputMode(
+            OutputMode::MATERIALIZED
+        ), recordingSpans(
+            false
+        ), outputMaterialized(
+            true
+        ), outputPointer(
+            nullptr
+        ), outputLength(
+            0
+        ) {}
+
+
+    Scrubber::Scrubber(
+            const char*   rawData,
+            unsigned long length
+        ):Engine(
+            rawData,
+            length
+        ), currentOutputMode(
+            OutputMode::MATERIALIZED
+        ), recordingSpans(
+            false
+        ), outputMaterialized(
+            true
+        ), outputPointer(
+            nullptr
+        ), outputLength(
+            0
+        ) {}
 
 
     Scrubber::~Scrubber() {}
 
 
-    void Scrubber::scrub() {
-        outputData.clear();
-        Engine::scrub();
+    void Scrubber::setInput(const QByteArray& rawData, Scrubber::InputMode inputMode) {
+        inputData = rawData;
+        Engine::setInput(inputData.constData(), static_cast<unsigned long>(inputData.size()), inputMode);
+    }
+
+
+    void Scrubber::setInput(const char* rawData, unsigned long length) {
+        inputData = QByteArray();
+        Engine::setInput(rawData, length);
+    }
+
+
+    bool Scrubber::scrub() {
+        discardContents(outputData);
+        outputSpans.clear();
+
+        recordingSpans     = currentOutputMode == OutputMode::SPANS;
+        outputMaterialized = !recordingSpans;
+        setStaging(false);
+
+        if (!recordingSpans) {
+            unsigned long maximumLength = maximumOutputLength();
+
+            if (maximumLength > maximumOutputSize) {
+                return false;
+            }
+
+            outputData.resize(static_cast<int>(maximumLength));
+            outputPointer = outputData.data();
+            outputLength  = 0;
+        }
+
+        bool success = Engine::scrub();
+
+        if (!recordingSpans) {
+            outputData.resize(static_cast<int>(outputLength));
+            outputPointer = nullptr;
+        }
+
+        return success;
+    }
+
+
+    QByteArray Scrubber::scrub(
+            const QByteArray&    rawData,
+            Scrubber::Backend    scrubBackend,
+            Scrubber::Utf8Policy scrubPolicy
+        ) {
+        Scrubber scrubber(rawData, InputMode::READ_ONLY);
+        scrubber.setBackend(scrubBackend);
+        scrubber.setUtf8Policy(scrubPolicy);
+
+        return scrubber.scrub() ? scrubber.outputData : QByteArray();
     }
 
 
-    QByteArray Scrubber::scrub(const QByteArray& rawData) {
-        Scrubber scrubber(rawData);
-        scrubber.scrub();
-        return scrubber.outputData;
+    bool Scrubber::scrub(
+            const QByteArray&    rawData,
+            QByteArray&          output,
+            Scrubber::Backend    scrubBackend,
+            Scrubber::Utf8Policy scrubPolicy
+        ) {
+        Scrubber scrubber(rawData, InputMode::READ_ONLY);
+        scrubber.setBackend(scrubBackend);
+        scrubber.setUtf8Policy(scrubPolicy);
+
+        scrubber.outputData.swap(output);
+        bool success = scrubber.scrub();
+
+        if (!success) {
+            discardContents(scrubber.outputData);
+        }
+
+        output.swap(scrubber.outputData);
+        return success;
+    }
+
+
+    bool Scrubber::scrubInPlace(
+            QByteArray&          data,
+            Scrubber::Backend    scrubBackend,
+            Scrubber::Utf8Policy scrubPolicy
+        ) {
+        unsigned long length         = static_cast<unsigned long>(data.size());
+        unsigned long replacedLength = length;
+        unsigned long outputLength;
+
+        if (scrubPolicy == Utf8Policy::REPLACE) {
+            replacedLength = Utf8::replacedLength(data.constData(), length);
+        }
+
+        if (replacedLength + paddingLength > maximumOutputSize) {
+            return false;
+        }
+
+        data.resize(static_cast<int>(replacedLength + paddingLength));
+        bool success = Engine::scrubInPlace(
+            data.data(),
+            length,
+            replacedLength + paddingLength,
+            outputLength,
+            scrubBackend,
+            scrubPolicy
+        );
+
+        data.resize(static_cast<int>(success ? outputLength : length));
+        return success;
+    }
+
+
+    void Scrubber::begin() {
+        discardContents(outputData);
+        outputSpans.clear();
+
+        recordingSpans     = false;
+        outputMaterialized = true;
+        setStaging(false);
+
+        Engine::begin();
+    }
+
+
+    QByteArray Scrubber::finish() {
+        if (!Engine::finish()) {
+            discardContents(outputData);
+        }
+
+        return outputData;
+    }
+
+
+    void Scrubber::setOutputMode(Scrubber::OutputMode newOutputMode) {
+        currentOutputMode = newOutputMode;
+    }
+
+
+    Scrubber::OutputMode Scrubber::outputMode() const {
+        return currentOutputMode;
     }
 
 
     const QByteArray& Scrubber::output() const {
+        if (!outputMaterialized) {
+            if (outputSpans.length() <= maximumOutputSize) {
+                outputData.resize(static_cast<int>(outputSpans.length()));
+                outputSpans.copyTo(outputData.data());
+            }
+
+            outputMaterialized = true;
+        }
+
         return outputData;
     }
 
 
+    const std::vector<Scrubber::Span>& Scrubber::spans() const {
+        return outputSpans.spans();
+    }
+
+
     void Scrubber::update(const char* inputPointer, unsigned long charsToCopy) {
-        outputData.append(inputPointer, charsToCopy);
+        if (recordingSpans) {
+            outputSpans.update(inputPointer, charsToCopy);
+        } else if (outputPointer != nullptr) {
+            std::memcpy(outputPointer + outputLength, inputPointer, charsToCopy);
+            outputLength += charsToCopy;
+        } else {
+            outputData.append(inputPointer, charsToCopy);
+        }
     }
 }
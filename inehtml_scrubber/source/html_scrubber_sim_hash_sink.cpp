@@ -0,0 +1,158 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the SimHash similarity fingerprint sink.
+***********************************************************************************************************************/
+
+#include <bitset>
+#include <cassert>
+#include <cstdint>
+
+#include "html_scrubber_sink.h"
+#include "html_scrubber_sim_hash_sink.h"
+
+namespace {
+    /*
+     * FNV-1a parameters used to hash words.
+     */
+    const std::uint64_t fnvOffset = 0xCBF29CE484222325ULL;
+    const std::uint64_t fnvPrime  = 0x00000100000001B3ULL;
+
+    /*
+     * Function that mixes a value so that every output bit depends on every input bit.
+     */
+    inline std::uint64_t avalanche(std::uint64_t value) {
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+        return value ^ (value >> 31);
+    }
+}
+
+namespace HtmlScrubber {
+    SimHashSink::SimHashSink(unsigned shingleLength):currentShingleLength(shingleLength) {
+        assert(shingleLength >= 1 && shingleLength <= maximumShingleLength);
+        clear();
+    }
+
+
+    SimHashSink::~SimHashSink() {}
+
+
+    void SimHashSink::update(const char* data, unsigned long length) {
+        std::uint64_t hash = wordHash;
+
+        for (unsigned long index=0 ; index<length ; ++index) {
+            std::uint8_t byte = static_cast<std::uint8_t>(data[index]);
+
+            if (byte <= 0x20 || byte == 0x7F) {
+                if (wordLength > 0) {
+                    wordHash = hash;
+                    closeWord();
+                    hash = fnvOffset;
+                }
+            } else {
+                hash = (hash ^ byte) * fnvPrime;
+                ++wordLength;
+            }
+        }
+
+        wordHash = hash;
+    }
+
+
+    void SimHashSink::clear() {
+        wordHash    = fnvOffset;
+        wordLength  = 0;
+        numberWords = 0;
+
+        numberShingles = 0;
+
+        for (unsigned bit=0 ; bit<64 ; ++bit) {
+            setBits[bit] = 0;
+        }
+    }
+
+
+    void SimHashSink::finish() {
+        closeWord();
+
+        if (numberWords > 0 && numberWords < currentShingleLength) {
+            addShingle(static_cast<unsigned>(numberWords));
+        }
+    }
+
+
+    std::uint64_t SimHashSink::result() const {
+        std::uint64_t fingerprint = 0;
+
+        for (unsigned bit=0 ; bit<64 ; ++bit) {
+            if (2 * static_cast<unsigned long>(setBits[bit]) > numberShingles) {
+                fingerprint |= std::uint64_t(1) << bit;
+            }
+        }
+
+        return fingerprint;
+    }
+
+
+    unsigned SimHashSink::shingleLength() const {
+        return currentShingleLength;
+    }
+
+
+    unsigned SimHashSink::distance(std::uint64_t fingerprint1, std::uint64_t fingerprint2) {
+        return static_cast<unsigned>(std::bitset<64>(fingerprint1 ^ fingerprint2).count());
+    }
+
+
+    void SimHashSink::closeWord() {
+        if (wordLength > 0) {
+            recentWords[numberWords % currentShingleLength] = wordHash;
+            ++numberWords;
+
+            if (numberWords >= currentShingleLength) {
+                addShingle(currentShingleLength);
+            }
+
+            wordHash   = fnvOffset;
+            wordLength = 0;
+        }
+    }
+
+
+    void SimHashSink::addShingle(unsigned numberWordsInShingle) {
+        unsigned long firstWord = numberWords - numberWordsInShingle;
+        std::uint64_t hash      = 0;
+
+        for (unsigned word=0 ; word<numberWordsInShingle ; ++word) {
+            std::uint64_t recentHash = recentWords[(firstWord + word) % currentShingleLength];
+            hash ^= word == 0 ? recentHash : (recentHash << (7 * word)) | (recentHash >> (64 - 7 * word));
+        }
+
+        hash = avalanche(hash);
+
+        std::uint32_t lowHash  = static_cast<std::uint32_t>(hash);
+        std::uint32_t highHash = static_cast<std::uint32_t>(hash >> 32);
+
+        for (unsigned bit=0 ; bit<32 ; ++bit) {
+            setBits[bit]      += (lowHash >> bit) & 1;
+            setBits[bit + 32] += (highHash >> bit) & 1;
+        }
+
+        ++numberShingles;
+    }
+}
@@ -0,0 +1,72 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the span recording sink.
+***********************************************************************************************************************/
+
+#include <cstring>
+#include <vector>
+
+#include "html_scrubber_sink.h"
+#include "html_scrubber_span_sink.h"
+
+namespace HtmlScrubber {
+    SpanSink::SpanSink():currentLength(0) {}
+
+
+    SpanSink::~SpanSink() {}
+
+
+    bool SpanSink::retainsData() const {
+        return true;
+    }
+
+
+    void SpanSink::update(const char* data, unsigned long length) {
+        if (!currentSpans.empty() && currentSpans.back().data + currentSpans.back().length == data) {
+            currentSpans.back().length += length;
+        } else {
+            currentSpans.push_back(Span { data, length });
+        }
+
+        currentLength += length;
+    }
+
+
+    void SpanSink::clear() {
+        currentSpans.clear();
+        currentLength = 0;
+    }
+
+
+    const std::vector<SpanSink::Span>& SpanSink::spans() const {
+        return currentSpans;
+    }
+
+
+    unsigned long SpanSink::length() const {
+        return currentLength;
+    }
+
+
+    void SpanSink::copyTo(char* destination) const {
+        for (const Span& span : currentSpans) {
+            std::memcpy(destination, span.data, span.length);
+            destination += span.length;
+        }
+    }
+}
@@ -0,0 +1,197 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the all start states parser simulation.
+***********************************************************************************************************************/
+
+#include <cstdint>
+
+#if (defined(__AVX512VBMI__) && defined(__AVX512BW__))
+    #include <immintrin.h>
+    #define HTML_SCRUBBER_VBMI
+#elif (defined(__SSSE3__) || defined(__AVX__))
+    #include <tmmintrin.h>
+    #define HTML_SCRUBBER_SSSE3
+#endif
+
+#include "html_scrubber_parser.h"
+#include "html_scrubber_parser_table.h"
+#include "html_scrubber_state_map.h"
+
+namespace HtmlScrubber {
+    namespace {
+        #if (defined(HTML_SCRUBBER_SSSE3))
+            /*
+             * Looks up 16 indexes, each below 64, in a 64 entry table held in four registers.  The selects hold, for
+             * each of the four table registers, a mask of the lanes whose index falls in that register.
+             */
+            inline __m128i lookup(const __m128i* table, __m128i index, const __m128i* selects) {
+                return _mm_or_si128(
+                    _mm_or_si128(
+                        _mm_and_si128(_mm_shuffle_epi8(table[0], index), selects[0]),
+                        _mm_and_si128(_mm_shuffle_epi8(table[1], index), selects[1])
+                    ),
+                    _mm_or_si128(
+                        _mm_and_si128(_mm_shuffle_epi8(table[2], index), selects[2]),
+                        _mm_and_si128(_mm_shuffle_epi8(table[3], index), selects[3])
+                    )
+                );
+            }
+        #endif
+    }
+
+    StateMap::StateMap(const std::uint8_t* hookCaptures) {
+        for (unsigned column=0 ; column<numberColumns ; ++column) {
+            identity(columns[column]);
+        }
+
+        for (unsigned byte=0 ; byte<256 ; ++byte) {
+            char c = static_cast<char>(byte);
+
+            if (byte < 0x80) {
+                unsigned column   = static_cast<unsigned>(ParserTable::byteClass(c));
+                byteColumns[byte] = static_cast<std::uint8_t>(column);
+
+                for (unsigned state=0 ; state<static_cast<unsigned>(States::NUMBER_STATES) ; ++state) {
+                    const ParserTable::Transition& transition = ParserTable::transition(static_cast<States>(state), c);
+
+                    columns[column].states[state]   = transition.nextState;
+                    columns[column].captures[state] = hookCaptures[static_cast<unsigned>(transition.hook)];
+                }
+            } else {
+                byteColumns[byte] = static_cast<std::uint8_t>(identityColumn);
+            }
+        }
+    }
+
+
+    StateMap::~StateMap() {}
+
+
+    void StateMap::identity(StateMap::Map& map) {
+        for (unsigned entry=0 ; entry<numberEntries ; ++entry) {
+            map.states[entry]   = static_cast<std::uint8_t>(entry);
+            map.captures[entry] = keepCapture;
+        }
+    }
+
+
+    bool StateMap::accelerated() {
+        #if (defined(HTML_SCRUBBER_VBMI))
+            return true;
+        #else
+            return false;
+        #endif
+    }
+
+
+    void StateMap::apply(StateMap::Map& map, const char* data, unsigned long length) const {
+        #if (defined(HTML_SCRUBBER_VBMI))
+            __m512i states   = _mm512_loadu_si512(map.states);
+            __m512i captures = _mm512_loadu_si512(map.captures);
+
+            for (unsigned long index=0 ; index<length ; ++index) {
+                unsigned column = byteColumns[static_cast<std::uint8_t>(data[index])];
+
+                if (column != identityColumn) {
+                    const Map& transitions = columns[column];
+
+                    __m512i   newCaptures = _mm512_permutexvar_epi8(states, _mm512_loadu_si512(transitions.captures));
+                    __mmask64 changed     = _mm512_test_epi8_mask(newCaptures, newCaptures);
+
+                    states   = _mm512_permutexvar_epi8(states, _mm512_loadu_si512(transitions.states));
+                    captures = _mm512_mask_mov_epi8(captures, changed, newCaptures);
+                }
+            }
+
+            _mm512_storeu_si512(map.states, states);
+            _mm512_storeu_si512(map.captures, captures);
+        #elif (defined(HTML_SCRUBBER_SSSE3))
+            const unsigned lanes = numberEntries / 16;
+            const __m128i  zero  = _mm_setzero_si128();
+
+            __m128i states[lanes];
+            __m128i captures[lanes];
+
+            for (unsigned lane=0 ; lane<lanes ; ++lane) {
+                states[lane]   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(map.states + 16 * lane));
+                captures[lane] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(map.captures + 16 * lane));
+            }
+
+            for (unsigned long index=0 ; index<length ; ++index) {
+                unsigned column = byteColumns[static_cast<std::uint8_t>(data[index])];
+
+                if (column != identityColumn) {
+                    const Map& transitions = columns[column];
+
+                    __m128i stateTable[lanes];
+                    __m128i captureTable[lanes];
+
+                    for (unsigned lane=0 ; lane<lanes ; ++lane) {
+                        stateTable[lane]   = _mm_loadu_si128(
+                            reinterpret_cast<const __m128i*>(transitions.states + 16 * lane)
+                        );
+                        captureTable[lane] = _mm_loadu_si128(
+                            reinterpret_cast<const __m128i*>(transitions.captures + 16 * lane)
+                        );
+                    }
+
+                    for (unsigned lane=0 ; lane<lanes ; ++lane) {
+                        __m128i high = _mm_and_si128(_mm_srli_epi16(states[lane], 4), _mm_set1_epi8(0x0F));
+                        __m128i selects[lanes];
+
+                        for (unsigned table=0 ; table<lanes ; ++table) {
+                            selects[table] = _mm_cmpeq_epi8(high, _mm_set1_epi8(static_cast<char>(table)));
+                        }
+
+                        __m128i newCaptures = lookup(captureTable, states[lane], selects);
+                        __m128i unchanged   = _mm_cmpeq_epi8(newCaptures, zero);
+
+                        states[lane]   = lookup(stateTable, states[lane], selects);
+                        captures[lane] = _mm_or_si128(
+                            _mm_and_si128(unchanged, captures[lane]),
+                            _mm_andnot_si128(unchanged, newCaptures)
+                        );
+                    }
+                }
+            }
+
+            for (unsigned lane=0 ; lane<lanes ; ++lane) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(map.states + 16 * lane), states[lane]);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(map.captures + 16 * lane), captures[lane]);
+            }
+        #else
+            for (unsigned long index=0 ; index<length ; ++index) {
+                unsigned column = byteColumns[static_cast<std::uint8_t>(data[index])];
+
+                if (column != identityColumn) {
+                    const Map& transitions = columns[column];
+
+                    for (unsigned entry=0 ; entry<numberEntries ; ++entry) {
+                        std::uint8_t state   = map.states[entry];
+                        std::uint8_t capture = transitions.captures[state];
+
+                        map.states[entry] = transitions.states[state];
+                        if (capture != keepCapture) {
+                            map.captures[entry] = capture;
+                        }
+                    }
+                }
+            }
+        #endif
+    }
+}
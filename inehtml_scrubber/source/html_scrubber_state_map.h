@@ -0,0 +1,146 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides a simulation of the parser state machine from every start state at once.
+***********************************************************************************************************************/
+
+/* .. sphinx-project inehtmlscrubber */
+
+#ifndef HTML_SCRUBBER_STATE_MAP_H
+#define HTML_SCRUBBER_STATE_MAP_H
+
+#include <cstdint>
+
+#include "html_scrubber_parser.h"
+#include "html_scrubber_parser_table.h"
+
+namespace HtmlScrubber {
+    /**
+     * Class that simulates the parser from every possible start state at once.
+     *
+     * The parser has fewer than 64 states so the effect of a run of bytes can be described by a map from start state
+     * to end state held in 64 bytes.  Applying a byte to a map is a single table lookup per entry, which is performed
+     * with byte shuffles: VPERMB when the library is built with AVX-512 VBMI enabled, PSHUFB when built with SSSE3
+     * enabled, and a scalar loop otherwise.  Because the map does not depend on the actual start state, maps for
+     * independent blocks of data can be built without any serial dependency between them and composed afterwards.
+     *
+     * Each map also tracks, for every start state, the capture setting left by the last transition hook that changed
+     * it.  Capture settings are opaque small integers supplied by the caller, with \ref keepCapture indicating that
+     * no hook changed the setting.
+     *
+     * Bytes with the high bit set are treated as leaving the state unchanged, which is correct for valid UTF-8 where
+     * multi-byte sequences are never presented to the parser.
+     */
+    class StateMap {
+        public:
+            /**
+             * Type used to represent parser states.
+             */
+            typedef Parser::States States;
+
+            /**
+             * The number of entries in a map.
+             */
+            static constexpr unsigned numberEntries = 64;
+
+            /**
+             * Capture value indicating that the capture setting is unchanged.
+             */
+            static constexpr std::uint8_t keepCapture = 0;
+
+            /**
+             * Structure holding a map from start state to end state and capture setting.
+             */
+            struct Map {
+                /**
+                 * The end state for each start state.
+                 */
+                std::uint8_t states[numberEntries];
+
+                /**
+                 * The capture setting for each start state.
+                 */
+                std::uint8_t captures[numberEntries];
+            };
+
+            /**
+             * Constructor
+             *
+             * \param[in] hookCaptures The capture setting applied by each transition hook, indexed by
+             *                         \ref HtmlScrubber::ParserTable::Hook.  Use \ref keepCapture for hooks that do
+             *                         not change the capture setting.
+             */
+            StateMap(const std::uint8_t* hookCaptures);
+
+            ~StateMap();
+
+            /**
+             * Method that sets a map to the identity map.
+             *
+             * \param[out] map The map to be set.
+             */
+            static void identity(Map& map);
+
+            /**
+             * Method that applies a run of bytes to a map.
+             *
+             * \param[in,out] map    The map to be updated.
+             *
+             * \param[in]     data   Pointer to the bytes to be applied.
+             *
+             * \param[in]     length The number of bytes to be applied.
+             */
+            void apply(Map& map, const char* data, unsigned long length) const;
+
+            /**
+             * Method that indicates if maps are built using VPERMB.  The SSSE3 and scalar builds apply a byte to a
+             * map several times more slowly than the parser consumes it, so maps are only worth building when this
+             * method returns true.
+             *
+             * \return Returns true if the library was built with AVX-512 VBMI enabled, see the vbmi configuration
+             *         option in inehtml_scrubber.pro.
+             */
+            static bool accelerated();
+
+        private:
+            static_assert(
+                static_cast<unsigned>(States::NUMBER_STATES) <= numberEntries,
+                "Too many parser states for a state map."
+            );
+
+            /**
+             * The number of columns.  One column per byte class plus an identity column for non-ASCII bytes.
+             */
+            static constexpr unsigned numberColumns = ParserTable::numberByteClasses + 1;
+
+            /**
+             * The column used for bytes that leave the state unchanged.
+             */
+            static constexpr unsigned identityColumn = ParserTable::numberByteClasses;
+
+            /**
+             * The transition maps for each column.
+             */
+            Map columns[numberColumns];
+
+            /**
+             * The column used by each byte value.
+             */
+            std::uint8_t byteColumns[256];
+    };
+};
+#endif
@@ -0,0 +1,311 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements UTF-8 validation.
+***********************************************************************************************************************/
+
+#include <cstdint>
+#include <cstring>
+
+#if (defined(__AVX2__))
+    #include <immintrin.h>
+#elif (defined(__SSSE3__) || defined(__AVX__))
+    #include <tmmintrin.h>
+    #define HTML_SCRUBBER_SSSE3
+#endif
+
+#include "html_scrubber_utf8.h"
+
+namespace HtmlScrubber {
+    namespace {
+        #if (defined(__AVX2__) || defined(HTML_SCRUBBER_SSSE3))
+            /*
+             * Error bits used by the lookup tables.  Each bit identifies one class of error detectable by examining a
+             * pair of adjacent bytes.  A pair is in error if the same bit is set in all three lookups.
+             */
+            const std::uint8_t tooShort     = 1 << 0; // 11______ 0_______ or 11______ 11______
+            const std::uint8_t tooLong      = 1 << 1; // 0_______ 10______
+            const std::uint8_t overlong3    = 1 << 2; // 11100000 100_____
+            const std::uint8_t tooLarge     = 1 << 3; // 11110100 1001____, 11110100 101_____, 11110101+ 10______
+            const std::uint8_t surrogate    = 1 << 4; // 11101101 101_____
+            const std::uint8_t overlong2    = 1 << 5; // 1100000_ 10______
+            const std::uint8_t tooLarge1000 = 1 << 6; // 11110101+ 1000____
+            const std::uint8_t overlong4    = 1 << 6; // 11110000 1000____
+            const std::uint8_t twoConts     = 1 << 7; // 10______ 10______
+            const std::uint8_t carry        = tooShort | tooLong | twoConts;
+
+            const std::uint8_t byte1HighTable[16] = {
+                tooLong, tooLong, tooLong, tooLong,
+                tooLong, tooLong, tooLong, tooLong,
+                twoConts, twoConts, twoConts, twoConts,
+                tooShort | overlong2,
+                tooShort,
+                tooShort | overlong3 | surrogate,
+                tooShort | tooLarge | tooLarge1000 | overlong4
+            };
+
+            const std::uint8_t byte1LowTable[16] = {
+                carry | overlong3 | overlong2 | overlong4,
+                carry | overlong2,
+                carry,
+                carry,
+                carry | tooLarge,
+                carry | tooLarge | tooLarge1000,
+                carry | tooLarge | tooLarge1000,
+                carry | tooLarge | tooLarge1000,
+                carry | tooLarge | tooLarge1000,
+                carry | tooLarge | tooLarge1000,
+                carry | tooLarge | tooLarge1000,
+                carry | tooLarge | tooLarge1000,
+                carry | tooLarge | tooLarge1000,
+                carry | tooLarge | tooLarge1000 | surrogate,
+                carry | tooLarge | tooLarge1000,
+                carry | tooLarge | tooLarge1000
+            };
+
+            const std::uint8_t byte2HighTable[16] = {
+                tooShort, tooShort, tooShort, tooShort,
+                tooShort, tooShort, tooShort, tooShort,
+                tooLong | overlong2 | twoConts | overlong3 | tooLarge1000 | overlong4,
+                tooLong | overlong2 | twoConts | overlong3 | tooLarge,
+                tooLong | overlong2 | twoConts | surrogate | tooLarge,
+                tooLong | overlong2 | twoConts | surrogate | tooLarge,
+                tooShort, tooShort, tooShort, tooShort
+            };
+
+            /*
+             * Maximum byte values at each position of the final block that do not start an incomplete sequence.
+             */
+            const std::uint8_t incompleteTable[32] = {
+                0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1
+            };
+        #endif
+
+        #if (defined(__AVX2__))
+            const unsigned blockSize = 32;
+
+            inline __m256i table(const std::uint8_t* values) {
+                __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+                return _mm256_broadcastsi128_si256(x);
+            }
+
+            template<int distance> inline __m256i previous(__m256i input, __m256i previousInput) {
+                return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previousInput, input, 0x21), 16 - distance);
+            }
+
+            inline __m256i checkBlock(__m256i input, __m256i previousInput) {
+                const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+
+                __m256i previous1  = previous<1>(input, previousInput);
+                __m256i byte1High  = _mm256_shuffle_epi8(
+                    table(byte1HighTable),
+                    _mm256_and_si256(_mm256_srli_epi16(previous1, 4), nibbleMask)
+                );
+                __m256i byte1Low   = _mm256_shuffle_epi8(table(byte1LowTable), _mm256_and_si256(previous1, nibbleMask));
+                __m256i byte2High  = _mm256_shuffle_epi8(
+                    table(byte2HighTable),
+                    _mm256_and_si256(_mm256_srli_epi16(input, 4), nibbleMask)
+                );
+                __m256i special    = _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+
+                __m256i previous2  = previous<2>(input, previousInput);
+                __m256i previous3  = previous<3>(input, previousInput);
+                __m256i thirdByte  = _mm256_subs_epu8(previous2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+                __m256i fourthByte = _mm256_subs_epu8(previous3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+                __m256i must23     = _mm256_and_si256(
+                    _mm256_or_si256(thirdByte, fourthByte),
+                    _mm256_set1_epi8(static_cast<char>(0x80))
+                );
+
+                return _mm256_xor_si256(must23, special);
+            }
+
+            inline __m256i incomplete(__m256i input) {
+                return _mm256_subs_epu8(
+                    input,
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(incompleteTable))
+                );
+            }
+
+            inline bool validateBlocks(const char* data, unsigned long length) {
+                __m256i       error              = _mm256_setzero_si256();
+                __m256i       previousInput      = _mm256_setzero_si256();
+                __m256i       previousIncomplete = _mm256_setzero_si256();
+                unsigned long index              = 0;
+
+                while (index < length) {
+                    __m256i input;
+
+                    if (index + blockSize <= length) {
+                        input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index));
+                    } else {
+                        char padded[blockSize];
+
+                        std::memset(padded, 0, blockSize);
+                        std::memcpy(padded, data + index, length - index);
+
+                        input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(padded));
+                    }
+
+                    if (_mm256_movemask_epi8(input) == 0) {
+                        error = _mm256_or_si256(error, previousIncomplete);
+                    } else {
+                        error              = _mm256_or_si256(error, checkBlock(input, previousInput));
+                        previousIncomplete = incomplete(input);
+                    }
+
+                    previousInput = input;
+                    index += blockSize;
+                }
+
+                error = _mm256_or_si256(error, previousIncomplete);
+                return _mm256_testz_si256(error, error) != 0;
+            }
+        #elif (defined(HTML_SCRUBBER_SSSE3))
+            const unsigned blockSize = 16;
+
+            inline __m128i table(const std::uint8_t* values) {
+                return _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+            }
+
+            inline __m128i checkBlock(__m128i input, __m128i previousInput) {
+                const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+
+                __m128i previous1  = _mm_alignr_epi8(input, previousInput, 15);
+                __m128i byte1High  = _mm_shuffle_epi8(
+                    table(byte1HighTable),
+                    _mm_and_si128(_mm_srli_epi16(previous1, 4), nibbleMask)
+                );
+                __m128i byte1Low   = _mm_shuffle_epi8(table(byte1LowTable), _mm_and_si128(previous1, nibbleMask));
+                __m128i byte2High  = _mm_shuffle_epi8(
+                    table(byte2HighTable),
+                    _mm_and_si128(_mm_srli_epi16(input, 4), nibbleMask)
+                );
+                __m128i special    = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+
+                __m128i previous2  = _mm_alignr_epi8(input, previousInput, 14);
+                __m128i previous3  = _mm_alignr_epi8(input, previousInput, 13);
+                __m128i thirdByte  = _mm_subs_epu8(previous2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+                __m128i fourthByte = _mm_subs_epu8(previous3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+                __m128i must23     = _mm_and_si128(
+                    _mm_or_si128(thirdByte, fourthByte),
+                    _mm_set1_epi8(static_cast<char>(0x80))
+                );
+
+                return _mm_xor_si128(must23, special);
+            }
+
+            inline __m128i incomplete(__m128i input) {
+                return _mm_subs_epu8(input, _mm_loadu_si128(reinterpret_cast<const __m128i*>(incompleteTable + 16)));
+            }
+
+            inline bool validateBlocks(const char* data, unsigned long length) {
+                __m128i       error              = _mm_setzero_si128();
+                __m128i       previousInput      = _mm_setzero_si128();
+                __m128i       previousIncomplete = _mm_setzero_si128();
+                unsigned long index              = 0;
+
+                while (index < length) {
+                    __m128i input;
+
+                    if (index + blockSize <= length) {
+                        input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+                    } else {
+                        char padded[blockSize];
+
+                        std::memset(padded, 0, blockSize);
+                        std::memcpy(padded, data + index, length - index);
+
+                        input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(padded));
+                    }
+
+                    if (_mm_movemask_epi8(input) == 0) {
+                        error = _mm_or_si128(error, previousIncomplete);
+                    } else {
+                        error              = _mm_or_si128(error, checkBlock(input, previousInput));
+                        previousIncomplete = incomplete(input);
+                    }
+
+                    previousInput = input;
+                    index += blockSize;
+                }
+
+                error = _mm_or_si128(error, previousIncomplete);
+                return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xFFFF;
+            }
+        #else
+            inline bool validateBlocks(const char* data, unsigned long length) {
+                unsigned long index = 0;
+
+                while (index < length) {
+                    if ((data[index] & 0x80) == 0) {
+                        ++index;
+                    } else {
+                        bool valid;
+                        index += Utf8::decode(data + index, length - index, valid);
+
+                        if (!valid) {
+                            return false;
+                        }
+                    }
+                }
+
+                return true;
+            }
+        #endif
+    }
+
+    const char Utf8::replacementCharacter[3] = {
+        static_cast<char>(0xEF),
+        static_cast<char>(0xBF),
+        static_cast<char>(0xBD)
+    };
+
+
+    bool Utf8::validate(const char* data, unsigned long length) {
+        return validateBlocks(data, length);
+    }
+
+
+    unsigned long Utf8::replacedLength(const char* data, unsigned long length) {
+        unsigned long result = length;
+
+        if (!validateBlocks(data, length)) {
+            unsigned long index = 0;
+
+            while (index < length) {
+                if ((data[index] & 0x80) == 0x00) {
+                    ++index;
+                } else {
+                    bool          valid;
+                    unsigned long sequence = decode(data + index, length - index, valid);
+
+                    if (!valid) {
+                        result = result - sequence + sizeof(replacementCharacter);
+                    }
+
+                    index += sequence;
+                }
+            }
+        }
+
+        return result;
+    }
+}
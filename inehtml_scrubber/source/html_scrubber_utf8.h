@@ -0,0 +1,217 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides UTF-8 classification and validation functions used by the scrubber.
+***********************************************************************************************************************/
+
+/* .. sphinx-project inehtmlscrubber */
+
+#ifndef HTML_SCRUBBER_UTF8_H
+#define HTML_SCRUBBER_UTF8_H
+
+#include <cstdint>
+
+#if (defined(__AVX2__))
+    #include <immintrin.h>
+#elif (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #include <emmintrin.h>
+#endif
+
+#if (defined(_MSC_VER))
+    #include <intrin.h>
+#endif
+
+namespace HtmlScrubber {
+    /**
+     * Class that classifies and validates UTF-8 data.
+     *
+     * Whole buffers are validated using the lookup algorithm described by Keiser and Lemire, "Validating UTF-8 In Less
+     * Than One Instruction Per Byte", which checks 16 or 32 bytes at a time using three nibble indexed table lookups.
+     * The vectorized implementation is used when the library is built with SSSE3 or AVX2 enabled.  A scalar
+     * implementation is used on other targets.
+     *
+     * Validation follows RFC 3629.  Overlong encodings, surrogates, code points above U+10FFFF, and truncated
+     * sequences are all reported as invalid.
+     */
+    class Utf8 {
+        public:
+            /**
+             * The UTF-8 encoding of the replacement character, U+FFFD.
+             */
+            static const char replacementCharacter[3];
+
+            /**
+             * Method that determines if a buffer holds valid UTF-8.
+             *
+             * \param[in] data   Pointer to the data to be validated.
+             *
+             * \param[in] length The length of the data, in bytes.
+             *
+             * \return Returns true if the data is valid UTF-8.  Returns false if the data is not valid UTF-8.
+             */
+            static bool validate(const char* data, unsigned long length);
+
+            /**
+             * Method that determines the length of a buffer once each maximal invalid subpart has been replaced by
+             * the replacement character.  Valid data is only validated, not decoded.
+             *
+             * \param[in] data   Pointer to the data to be examined.
+             *
+             * \param[in] length The length of the data, in bytes.
+             *
+             * \return Returns the length of the data after replacement, in bytes.
+             */
+            static unsigned long replacedLength(const char* data, unsigned long length);
+
+            /**
+             * Method that counts the leading bytes that have the high bit set.  In valid UTF-8 this is always a whole
+             * number of multi-byte sequences.
+             *
+             * \param[in] data   Pointer to the data to be examined.
+             *
+             * \param[in] length The length of the data, in bytes.
+             *
+             * \return Returns the number of leading non-ASCII bytes.
+             */
+            static inline unsigned long nonAsciiLength(const char* data, unsigned long length) {
+                unsigned long index = 0;
+
+                #if (defined(__AVX2__))
+                    while (index + 32 <= length) {
+                        __m256i  x    = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index));
+                        unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(x));
+
+                        if (mask != 0) {
+                            return index + lowestSetBit(mask);
+                        }
+
+                        index += 32;
+                    }
+                #elif (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+                    while (index + 16 <= length) {
+                        __m128i  x    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+                        unsigned mask = ~static_cast<unsigned>(_mm_movemask_epi8(x)) & 0xFFFF;
+
+                        if (mask != 0) {
+                            return index + lowestSetBit(mask);
+                        }
+
+                        index += 16;
+                    }
+                #endif
+
+                while (index < length && (data[index] & 0x80) != 0) {
+                    ++index;
+                }
+
+                return index;
+            }
+
+            /**
+             * Method that determines the length of the sequence announced by a lead byte.
+             *
+             * \param[in] lead The lead byte.  The byte must have the high bit set.
+             *
+             * \return Returns the length of the sequence, in bytes.  Returns 1 if the byte can not start a valid
+             *         sequence.
+             */
+            static inline unsigned long sequenceLength(char lead) {
+                std::uint8_t value = static_cast<std::uint8_t>(lead);
+                return   value >= 0xC2 && value <= 0xDF ? 2
+                       : value >= 0xE0 && value <= 0xEF ? 3
+                       : value >= 0xF0 && value <= 0xF4 ? 4
+                       :                                  1;
+            }
+
+            /**
+             * Method that decodes a single multi-byte sequence.
+             *
+             * \param[in]  data      Pointer to the first byte of the sequence.  The byte must have the high bit set.
+             *
+             * \param[in]  available The number of bytes available starting at data.
+             *
+             * \param[out] valid     Holds true if the sequence is valid.  Holds false if the sequence is invalid.
+             *
+             * \return Returns the length of the sequence if valid.  If invalid, returns the length of the maximal
+             *         invalid subpart, which is always at least 1.  Each invalid subpart should be replaced by a single
+             *         replacement character.
+             */
+            static inline unsigned long decode(const char* data, unsigned long available, bool& valid) {
+                std::uint8_t  lead   = static_cast<std::uint8_t>(data[0]);
+                unsigned long length;
+                std::uint8_t  low    = 0x80;
+                std::uint8_t  high   = 0xBF;
+
+                if (lead >= 0xC2 && lead <= 0xDF) {
+                    length = 2;
+                } else if (lead >= 0xE0 && lead <= 0xEF) {
+                    length = 3;
+
+                    if (lead == 0xE0) {
+                        low = 0xA0;
+                    } else if (lead == 0xED) {
+                        high = 0x9F;
+                    }
+                } else if (lead >= 0xF0 && lead <= 0xF4) {
+                    length = 4;
+
+                    if (lead == 0xF0) {
+                        low = 0x90;
+                    } else if (lead == 0xF4) {
+                        high = 0x8F;
+                    }
+                } else {
+                    length = 1;
+                }
+
+                unsigned long index = 1;
+                while (index < length && index < available) {
+                    std::uint8_t c = static_cast<std::uint8_t>(data[index]);
+
+                    if (c < low || c > high) {
+                        break;
+                    }
+
+                    low  = 0x80;
+                    high = 0xBF;
+                    ++index;
+                }
+
+                valid = (length > 1 && index == length);
+                return index;
+            }
+
+        private:
+            /**
+             * Method that returns the index of the lowest set bit.
+             *
+             * \param[in] mask The mask to be tested.  The value must be non-zero.
+             *
+             * \return Returns the zero based index of the lowest set bit.
+             */
+            static inline unsigned lowestSetBit(std::uint32_t mask) {
+                #if (defined(_MSC_VER))
+                    unsigned long index;
+                    _BitScanForward(&index, mask);
+                    return static_cast<unsigned>(index);
+                #else
+                    return static_cast<unsigned>(__builtin_ctz(mask));
+                #endif
+            }
+    };
+};
+#endif
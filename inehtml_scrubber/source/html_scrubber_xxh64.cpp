@@ -0,0 +1,222 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the XXH64 hash.
+***********************************************************************************************************************/
+
+#include <cstdint>
+#include <cstring>
+
+#include "html_scrubber_xxh64.h"
+
+namespace {
+    /*
+     * The XXH64 primes.
+     */
+    const std::uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+    const std::uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+    const std::uint64_t prime3 = 0x165667B19E3779F9ULL;
+    const std::uint64_t prime4 = 0x85EBCA77C2B2AE63ULL;
+    const std::uint64_t prime5 = 0x27D4EB2F165667C5ULL;
+
+    /*
+     * Function that rotates a value left.
+     */
+    inline std::uint64_t rotateLeft(std::uint64_t value, unsigned bits) {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    /*
+     * Function that reads a little endian 64-bit value.
+     */
+    inline std::uint64_t read64(const char* data) {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+        return (
+              static_cast<std::uint64_t>(bytes[0])
+            | (static_cast<std::uint64_t>(bytes[1]) << 8)
+            | (static_cast<std::uint64_t>(bytes[2]) << 16)
+            | (static_cast<std::uint64_t>(bytes[3]) << 24)
+            | (static_cast<std::uint64_t>(bytes[4]) << 32)
+            | (static_cast<std::uint64_t>(bytes[5]) << 40)
+            | (static_cast<std::uint64_t>(bytes[6]) << 48)
+            | (static_cast<std::uint64_t>(bytes[7]) << 56)
+        );
+    }
+
+    /*
+     * Function that reads a little endian 32-bit value.
+     */
+    inline std::uint64_t read32(const char* data) {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+        return (
+              static_cast<std::uint64_t>(bytes[0])
+            | (static_cast<std::uint64_t>(bytes[1]) << 8)
+            | (static_cast<std::uint64_t>(bytes[2]) << 16)
+            | (static_cast<std::uint64_t>(bytes[3]) << 24)
+        );
+    }
+
+    /*
+     * Function that mixes one lane of input into an accumulator.
+     */
+    inline std::uint64_t round(std::uint64_t accumulator, std::uint64_t lane) {
+        accumulator += lane * prime2;
+        accumulator  = rotateLeft(accumulator, 31);
+        return accumulator * prime1;
+    }
+
+    /*
+     * Function that merges an accumulator into the hash.
+     */
+    inline std::uint64_t mergeRound(std::uint64_t hash, std::uint64_t accumulator) {
+        hash ^= round(0, accumulator);
+        return hash * prime1 + prime4;
+    }
+}
+
+namespace HtmlScrubber {
+    Xxh64::Xxh64(std::uint64_t seed) {
+        reset(seed);
+    }
+
+
+    Xxh64::~Xxh64() {}
+
+
+    void Xxh64::reset(std::uint64_t seed) {
+        accumulators[0] = seed + prime1 + prime2;
+        accumulators[1] = seed + prime2;
+        accumulators[2] = seed;
+        accumulators[3] = seed - prime1;
+
+        currentSeed    = seed;
+        totalLength    = 0;
+        bufferedLength = 0;
+    }
+
+
+    void Xxh64::addData(const char* data, unsigned long length) {
+        totalLength += length;
+
+        if (bufferedLength + length < stripeLength) {
+            std::memcpy(buffer + bufferedLength, data, length);
+            bufferedLength += length;
+        } else {
+            if (bufferedLength > 0) {
+                unsigned long fill = stripeLength - bufferedLength;
+                std::memcpy(buffer + bufferedLength, data, fill);
+                consume(buffer, 1);
+
+                data   += fill;
+                length -= fill;
+            }
+
+            unsigned long numberStripes = length / stripeLength;
+            consume(data, numberStripes);
+
+            bufferedLength = length - numberStripes * stripeLength;
+            std::memcpy(buffer, data + numberStripes * stripeLength, bufferedLength);
+        }
+    }
+
+
+    std::uint64_t Xxh64::result() const {
+        std::uint64_t hash;
+
+        if (totalLength >= stripeLength) {
+            hash = (
+                  rotateLeft(accumulators[0], 1)
+                + rotateLeft(accumulators[1], 7)
+                + rotateLeft(accumulators[2], 12)
+                + rotateLeft(accumulators[3], 18)
+            );
+
+            hash = mergeRound(hash, accumulators[0]);
+            hash = mergeRound(hash, accumulators[1]);
+            hash = mergeRound(hash, accumulators[2]);
+            hash = mergeRound(hash, accumulators[3]);
+        } else {
+            hash = currentSeed + prime5;
+        }
+
+        hash += totalLength;
+
+        const char*   tail       = buffer;
+        unsigned long tailLength = bufferedLength;
+
+        while (tailLength >= 8) {
+            hash ^= round(0, read64(tail));
+            hash  = rotateLeft(hash, 27) * prime1 + prime4;
+
+            tail       += 8;
+            tailLength -= 8;
+        }
+
+        if (tailLength >= 4) {
+            hash ^= read32(tail) * prime1;
+            hash  = rotateLeft(hash, 23) * prime2 + prime3;
+
+            tail       += 4;
+            tailLength -= 4;
+        }
+
+        while (tailLength > 0) {
+            hash ^= static_cast<std::uint64_t>(static_cast<unsigned char>(*tail)) * prime5;
+            hash  = rotateLeft(hash, 11) * prime1;
+
+            ++tail;
+            --tailLength;
+        }
+
+        hash ^= hash >> 33;
+        hash *= prime2;
+        hash ^= hash >> 29;
+        hash *= prime3;
+        hash ^= hash >> 32;
+
+        return hash;
+    }
+
+
+    std::uint64_t Xxh64::hash(const char* data, unsigned long length, std::uint64_t seed) {
+        Xxh64 state(seed);
+        state.addData(data, length);
+        return state.result();
+    }
+
+
+    void Xxh64::consume(const char* data, unsigned long numberStripes) {
+        std::uint64_t accumulator0 = accumulators[0];
+        std::uint64_t accumulator1 = accumulators[1];
+        std::uint64_t accumulator2 = accumulators[2];
+        std::uint64_t accumulator3 = accumulators[3];
+
+        for (unsigned long stripe=0 ; stripe<numberStripes ; ++stripe) {
+            accumulator0 = round(accumulator0, read64(data));
+            accumulator1 = round(accumulator1, read64(data + 8));
+            accumulator2 = round(accumulator2, read64(data + 16));
+            accumulator3 = round(accumulator3, read64(data + 24));
+
+            data += stripeLength;
+        }
+
+        accumulators[0] = accumulator0;
+        accumulators[1] = accumulator1;
+        accumulators[2] = accumulator2;
+        accumulators[3] = accumulator3;
+    }
+}
@@ -0,0 +1,335 @@
+#!/usr/bin/env python3
+##-*-python-*-##########################################################################################################
+# Copyright 2022 - 2023 Inesonic, LLC.
+#
+# GNU Public License, Version 3:
+#   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+#   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+#   version.
+#   
+#   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+#   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+#   details.
+#   
+#   You should have received a copy of the GNU General Public License along with this program.  If not, see
+#   <https://www.gnu.org/licenses/>.
+########################################################################################################################
+
+"""
+Generates the statically dispatched HtmlScrubber::StaticParser from the ypg generated HtmlScrubber::Parser.
+
+The state machine in Parser::parse and the default transition methods are copied from the generated parser.  Calls to
+transition methods are redirected to the derived class so the engine's methods can be inlined.  Run this script
+whenever the parser is regenerated:
+
+    python3 tools/generate_static_parser.py include/html_scrubber_parser.h include/html_scrubber_static_parser.h
+"""
+
+import re
+import sys
+
+PROLOGUE = '''\
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \\file
+*
+* This header provides a statically dispatched variant of the \\ref HtmlScrubber::Parser base class.
+*
+* This header is generated from html_scrubber_parser.h by tools/generate_static_parser.py.  Do not edit it by hand.
+***********************************************************************************************************************/
+
+/* .. sphinx-project inehtml_parser */
+
+#ifndef INEHTML_SCRUBBER_STATIC_PARSER
+#define INEHTML_SCRUBBER_STATIC_PARSER
+
+#include <cassert>
+#include <cctype>
+
+#include "html_scrubber_parser.h"
+#include "html_scrubber_parser_table.h"
+
+namespace HtmlScrubber {
+    /**
+     * Parser base class using the curiously recurring template pattern.
+     *
+     * This class implements the same state machine as \\ref HtmlScrubber::Parser but calls transition methods on the
+     * derived class directly rather than through the virtual table, allowing the compiler to inline them into the
+     * state machine.  Derived classes hide the default transition methods they wish to handle.  Derived classes that
+     * declare their transition methods private must declare StaticParser<Derived> as a friend.
+     *
+     * \\param Derived The derived class.
+     */
+    template<typename Derived> class StaticParser {
+        public:
+            /**
+             * States.
+             */
+            typedef Parser::States States;
+
+        private:
+            /**
+             * The current state.
+             */
+            States currentState;
+
+        public:
+            /**
+             * Constructor.
+             */
+            StaticParser(): currentState(States::IN_TEXT_SPACE) {}
+
+            ~StaticParser() {}
+
+        protected:
+            /**
+             * Method you can use to determine the current state.
+             *
+             * \\return Returns the current state.
+             */
+            inline States state() const {
+                return currentState;
+            }
+
+'''
+
+MIDDLE = '''\
+
+            /**
+             * Method you can use to parse the next value using the compile-time transition table in
+             * \\ref HtmlScrubber::ParserTable.  The same transition methods are triggered as for \\ref parse.
+             *
+             * \\param[in,out] c The value to be parsed.  Called transition function can modify the value.
+             */
+            inline void parseTable(char& c) {
+                applyTransition(ParserTable::transition(currentState, c), c);
+            }
+
+            /**
+             * Method you can use to take a transition that has already been looked up.  The transition's hook is
+             * triggered and the state machine moves to the transition's next state.
+             *
+             * \\param[in]     transition The transition to be taken from the current state.
+             *
+             * \\param[in,out] c          The value that triggered the transition.  Called transition function can
+             *                           modify the value.
+             */
+            inline void applyTransition(const ParserTable::Transition& transition, char& c) {
+                States oldState = currentState;
+                States newState = static_cast<States>(transition.nextState);
+
+                switch (transition.hook) {
+                    case ParserTable::Hook::NONE: {
+                        break;
+                    }
+
+                    case ParserTable::Hook::START_TAG: {
+                        derived().startTag(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::MULTIPLE_WHITE_SPACE: {
+                        derived().multipleWhiteSpace(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::WHITESPACE: {
+                        derived().whitespace(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::RESUME_TEXT: {
+                        derived().resumeText(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::END_TAG: {
+                        derived().endTag(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::START_SRC_ATTRIBUTE: {
+                        derived().startSrcAttribute(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::END_SRC_ATTRIBUTE: {
+                        derived().endSrcAttribute(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::START_HREF_ATTRIBUTE: {
+                        derived().startHrefAttribute(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::END_HREF_ATTRIBUTE: {
+                        derived().endHrefAttribute(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::START_CITE_ATTRIBUTE: {
+                        derived().startCiteAttribute(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::END_CITE_ATTRIBUTE: {
+                        derived().endCiteAttribute(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::START_SCRIPT_SRC_ATTRIBUTE: {
+                        derived().startScriptSrcAttribute(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::END_SCRIPT_SRC_ATTRIBUTE: {
+                        derived().endScriptSrcAttribute(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::START_STYLE: {
+                        derived().startStyle(oldState, newState, c);
+                        break;
+                    }
+
+                    case ParserTable::Hook::END_STYLE: {
+                        derived().endStyle(oldState, newState, c);
+                        break;
+                    }
+
+                    default: {
+                        assert(false);
+                        break;
+                    }
+                }
+
+                currentState = newState;
+            }
+
+            /**
+             * Method you can use to move the state machine directly to a new state without triggering any transition
+             * methods.  Intended for callers that have already determined the outcome of several transitions at once.
+             *
+             * \\param[in] newState The new state.
+             */
+            inline void setState(States newState) {
+                currentState = newState;
+            }
+
+            /**
+             * Method that resets the state machine.
+             */
+            void reset() {
+                currentState = States::IN_TEXT_SPACE;
+            }
+
+'''
+
+EPILOGUE = '''\
+
+        private:
+            /**
+             * Method that returns this instance as the derived class.
+             *
+             * \\return Returns a reference to the derived class instance.
+             */
+            inline Derived& derived() {
+                return *static_cast<Derived*>(this);
+            }
+    };
+}
+
+#endif
+'''
+
+
+def extract_parse(lines):
+    """
+    Returns the lines holding the documentation and body of Parser::parse.
+
+    :param lines: The lines of the generated parser.
+    """
+
+    first = lines.index('            void parse(char& c) {')
+    last = lines.index('            }', first)
+
+    while lines[first].strip() != '/**':
+        first -= 1
+
+    return lines[first:last + 1]
+
+
+def extract_hooks(lines):
+    """
+    Returns the names of the transition methods and the lines holding their documentation and default bodies.
+
+    :param lines: The lines of the generated parser.
+    """
+
+    names = []
+    first = None
+    last = None
+
+    for index, line in enumerate(lines):
+        match = re.match(r'^            virtual void (\w+)\($', line)
+        if match:
+            names.append(match.group(1))
+
+            if first is None:
+                first = index
+                while lines[first].strip() != '/**':
+                    first -= 1
+
+            last = lines.index('                ) {}', index)
+
+    return names, lines[first:last + 1]
+
+
+def generate(parser):
+    """
+    Returns the text of the statically dispatched parser.
+
+    :param parser: The text of the generated parser.
+    """
+
+    lines = parser.split('\n')
+    names, hooks = extract_hooks(lines)
+    call = re.compile(r'^(\s+)(' + '|'.join(names) + r')\(currentState, ')
+
+    parse = []
+    for line in extract_parse(lines):
+        line = line.replace('            void parse(char& c) {', '            inline void parse(char& c) {')
+        parse.append(call.sub(r'\1derived().\2(currentState, ', line))
+
+    defaults = []
+    for line in hooks:
+        line = line.replace('* Virtual method triggered', '* Default method triggered')
+        defaults.append(line.replace('            virtual void ', '            inline void '))
+
+    return PROLOGUE + '\n'.join(parse) + '\n' + MIDDLE + '\n'.join(defaults) + '\n' + EPILOGUE
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 3:
+        sys.stderr.write('usage: generate_static_parser.py <parser header> <static parser header>\n')
+        sys.exit(1)
+
+    with open(sys.argv[1], newline='') as source:
+        text = generate(source.read())
+
+    with open(sys.argv[2], 'w', newline='') as destination:
+        destination.write(text)
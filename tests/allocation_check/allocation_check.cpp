@@ -0,0 +1,186 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file checks that the paths documented as making no heap allocations once warmed up do not allocate: scrubbing
+* into a reused output buffer, a scrubber rebound to new documents, the XXH64 functors, and, when built against Qt 6.3
+* or later, the digest functor.  Before Qt 6.3 the digest functor is checked to make no more than the one allocation per
+* document made by QCryptographicHash::result.  Each path is run once over a set of documents to warm it up and then
+* run again while allocations are counted.  Allocations are counted by the test-only counter in allocation_counter.cpp.
+***********************************************************************************************************************/
+
+#include <QtGlobal>
+#include <QByteArray>
+#include <QCryptographicHash>
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "html_scrubber_scrubber.h"
+#include "html_scrubber_hasher.h"
+#include "html_scrubber_fast_hasher.h"
+
+#include "document_generator.h"
+#include "allocation_counter.h"
+
+namespace {
+    typedef HtmlScrubber::Scrubber            Scrubber;
+    typedef HtmlScrubber::Hasher              Hasher;
+    typedef HtmlScrubber::FastHasher          FastHasher;
+    typedef HtmlScrubber::Scrubber::InputMode InputMode;
+
+    using DocumentGenerator::generateDocument;
+
+    /*
+     * Checks that allocations are counted, including allocations made by Qt.  Returns 1 if allocations are not being
+     * counted and 0 otherwise.
+     */
+    unsigned checkCounting() {
+        unsigned      result = 0;
+        unsigned long before = AllocationCounter::allocations();
+        QByteArray    probe(4096, 'x');
+
+        if (AllocationCounter::allocations() == before) {
+            #if (defined(__GLIBC__))
+                std::cout << "allocations made by QByteArray are not counted" << std::endl;
+                result = 1;
+            #else
+                std::cout << "allocations made by Qt are not counted on this target, only operator new is checked"
+                          << std::endl;
+            #endif
+        }
+
+        return result;
+    }
+
+    /*
+     * Runs a path once to warm it up and again while counting allocations.  Returns 1 if the second run made more
+     * than the allowed number of allocations and 0 otherwise.
+     */
+    template<typename Path> unsigned checkPath(
+            const char*    name,
+            const Path&    path,
+            unsigned long& numberChecked,
+            unsigned long  allowedAllocations = 0
+        ) {
+        unsigned result = 0;
+
+        path();
+
+        unsigned long before      = AllocationCounter::allocations();
+        path();
+        unsigned long allocations = AllocationCounter::allocations() - before;
+
+        if (allocations > allowedAllocations) {
+            std::cout << name << ": " << allocations << " allocations after warm-up" << std::endl;
+            result = 1;
+        }
+
+        ++numberChecked;
+        return result;
+    }
+}
+
+int main() {
+    unsigned long numberChecked    = 0;
+    unsigned      numberMismatches = checkCounting();
+
+    /*
+     * The largest document comes first, so the warm-up run grows every buffer to its final size.
+     */
+    std::vector<QByteArray> documents;
+    for (unsigned documentIndex=0 ; documentIndex<8 ; ++documentIndex) {
+        documents.push_back(generateDocument<QByteArray>(documentIndex + 1, 40000 / (documentIndex + 1), false));
+    }
+
+    QByteArray output;
+    numberMismatches += checkPath(
+        "scrub into a reused buffer",
+        [&]() {
+            for (const QByteArray& document : documents) {
+                Scrubber::scrub(document, output);
+            }
+        },
+        numberChecked
+    );
+
+    Scrubber scrubber;
+    numberMismatches += checkPath(
+        "rebound scrubber, read only",
+        [&]() {
+            for (const QByteArray& document : documents) {
+                scrubber.setInput(document, InputMode::READ_ONLY);
+                scrubber.scrub();
+            }
+        },
+        numberChecked
+    );
+
+    numberMismatches += checkPath(
+        "rebound scrubber, copy",
+        [&]() {
+            for (const QByteArray& document : documents) {
+                scrubber.setInput(document, InputMode::COPY);
+                scrubber.scrub();
+            }
+        },
+        numberChecked
+    );
+
+    numberMismatches += checkPath(
+        "rebound scrubber, raw data",
+        [&]() {
+            for (const QByteArray& document : documents) {
+                scrubber.setInput(document.constData(), static_cast<unsigned long>(document.size()));
+                scrubber.scrub();
+            }
+        },
+        numberChecked
+    );
+
+    std::uint64_t hash = 0;
+    numberMismatches += checkPath(
+        "XXH64 functors",
+        [&]() {
+            for (const QByteArray& document : documents) {
+                Hasher::scrubAndHash(document.constData(), static_cast<unsigned long>(document.size()), hash);
+                FastHasher::scrubAndHash(document, hash);
+            }
+        },
+        numberChecked
+    );
+
+    #if (QT_VERSION >= QT_VERSION_CHECK(6, 3, 0))
+        unsigned long digestAllocations = 0;
+    #else
+        unsigned long digestAllocations = static_cast<unsigned long>(documents.size());
+    #endif
+
+    numberMismatches += checkPath(
+        "digest functor",
+        [&]() {
+            for (const QByteArray& document : documents) {
+                Hasher::scrubAndDigest(document, QCryptographicHash::Sha256);
+            }
+        },
+        numberChecked,
+        digestAllocations
+    );
+
+    std::cout << numberChecked << " paths checked, " << numberMismatches << " failures, Qt " << qVersion() << std::endl;
+    return numberMismatches == 0 ? 0 : 1;
+}
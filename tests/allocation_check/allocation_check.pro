@@ -0,0 +1,95 @@
+##-*-makefile-*-########################################################################################################
+# Copyright 2022 - 2023 Inesonic, LLC.
+#
+# GNU Public License, Version 3:
+#   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+#   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+#   version.
+#   
+#   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+#   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+#   details.
+#   
+#   You should have received a copy of the GNU General Public License along with this program.  If not, see
+#   <https://www.gnu.org/licenses/>.
+########################################################################################################################
+
+TEMPLATE = app
+
+########################################################################################################################
+# Basic build characteristics
+#
+# Checks that the paths documented as allocation free make no heap allocations once warmed up.  Run with
+# "make check".
+#
+
+QT += core
+QT -= gui
+CONFIG += console c++14 thread testcase
+CONFIG -= app_bundle
+
+########################################################################################################################
+# Includes
+#
+
+INCLUDEPATH += ../../inehtml_scrubber/include \
+               ../../inehtml_scrubber/source \
+               ../common
+HEADERS = allocation_counter.h \
+          ../common/document_generator.h \
+          ../../inehtml_scrubber/include/html_scrubber_parser.h \
+          ../../inehtml_scrubber/include/html_scrubber_parser_table.h \
+          ../../inehtml_scrubber/include/html_scrubber_static_parser.h \
+          ../../inehtml_scrubber/include/html_scrubber_sink.h \
+          ../../inehtml_scrubber/include/html_scrubber_span_sink.h \
+          ../../inehtml_scrubber/include/html_scrubber_engine.h \
+          ../../inehtml_scrubber/include/html_scrubber_digest.h \
+          ../../inehtml_scrubber/include/html_scrubber_xxh64.h \
+          ../../inehtml_scrubber/include/html_scrubber_fast_hasher.h \
+          ../../inehtml_scrubber/include/html_scrubber_chunk_hash_sink.h \
+          ../../inehtml_scrubber/include/html_scrubber_sim_hash_sink.h \
+          ../../inehtml_scrubber/include/html_scrubber_hasher.h \
+          ../../inehtml_scrubber/include/html_scrubber_scrubber.h \
+          ../../inehtml_scrubber/source/html_scrubber_engine_step.h \
+          ../../inehtml_scrubber/source/html_scrubber_keyword_matcher.h \
+          ../../inehtml_scrubber/source/html_scrubber_mapped_file.h \
+          ../../inehtml_scrubber/source/html_scrubber_scanner.h \
+          ../../inehtml_scrubber/source/html_scrubber_state_map.h \
+          ../../inehtml_scrubber/source/html_scrubber_utf8.h \
+
+########################################################################################################################
+# Source files
+#
+
+SOURCES = allocation_check.cpp \
+          allocation_counter.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_parser_table.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_state_map.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_utf8.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_sink.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_span_sink.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_engine.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_digest.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_xxh64.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_mapped_file.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_fast_hasher.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_chunk_hash_sink.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_sim_hash_sink.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_hasher.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_scrubber.cpp \
+
+########################################################################################################################
+# Locate build intermediate and output products
+#
+
+TARGET = allocation_check
+
+CONFIG(debug, debug|release) {
+    unix:DESTDIR = build/debug
+    win32:DESTDIR = build/Debug
+} else {
+    unix:DESTDIR = build/release
+    win32:DESTDIR = build/Release
+}
+
+OBJECTS_DIR = $${DESTDIR}/objects
@@ -0,0 +1,188 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements accounting of heap allocations for the allocation check.
+***********************************************************************************************************************/
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "allocation_counter.h"
+
+namespace {
+    /*
+     * The number of allocations made by the current thread.
+     */
+    thread_local unsigned long threadAllocations = 0;
+}
+
+#if (defined(__GLIBC__))
+
+    /*
+     * The C library allocator is replaced by versions that count calls before calling the glibc implementations.
+     * The replacements are found by symbol interposition, so calls made from shared libraries, including
+     * QByteArray and the C++ runtime's operator new, are counted too.
+     */
+    extern "C" {
+        void* __libc_malloc(std::size_t size);
+        void* __libc_calloc(std::size_t numberElements, std::size_t elementSize);
+        void* __libc_realloc(void* pointer, std::size_t size);
+        void* __libc_memalign(std::size_t alignment, std::size_t size);
+
+        void* malloc(std::size_t size) noexcept {
+            ++threadAllocations;
+            return __libc_malloc(size);
+        }
+
+
+        void* calloc(std::size_t numberElements, std::size_t elementSize) noexcept {
+            ++threadAllocations;
+            return __libc_calloc(numberElements, elementSize);
+        }
+
+
+        void* realloc(void* pointer, std::size_t size) noexcept {
+            ++threadAllocations;
+            return __libc_realloc(pointer, size);
+        }
+
+
+        void* memalign(std::size_t alignment, std::size_t size) noexcept {
+            ++threadAllocations;
+            return __libc_memalign(alignment, size);
+        }
+
+
+        void* aligned_alloc(std::size_t alignment, std::size_t size) noexcept {
+            ++threadAllocations;
+            return __libc_memalign(alignment, size);
+        }
+
+
+        int posix_memalign(void** pointer, std::size_t alignment, std::size_t size) noexcept {
+            int result = 0;
+
+            if (alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0) {
+                result = EINVAL;
+            } else {
+                ++threadAllocations;
+
+                void* allocated = __libc_memalign(alignment, size);
+                if (allocated == nullptr) {
+                    result = ENOMEM;
+                } else {
+                    *pointer = allocated;
+                }
+            }
+
+            return result;
+        }
+    }
+
+#else
+
+    namespace {
+        /*
+         * Function that counts and performs an allocation.  Follows the standard new handler protocol on failure.
+         */
+        void* countedAllocate(std::size_t size) {
+            ++threadAllocations;
+
+            if (size == 0) {
+                size = 1;
+            }
+
+            void* result = std::malloc(size);
+            while (result == nullptr) {
+                std::new_handler handler = std::get_new_handler();
+                if (handler == nullptr) {
+                    throw std::bad_alloc();
+                }
+
+                handler();
+                result = std::malloc(size);
+            }
+
+            return result;
+        }
+    }
+
+    void* operator new(std::size_t size) {
+        return countedAllocate(size);
+    }
+
+
+    void* operator new[](std::size_t size) {
+        return countedAllocate(size);
+    }
+
+
+    void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+        try {
+            return countedAllocate(size);
+        } catch (...) {
+            return nullptr;
+        }
+    }
+
+
+    void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+        try {
+            return countedAllocate(size);
+        } catch (...) {
+            return nullptr;
+        }
+    }
+
+
+    void operator delete(void* pointer) noexcept {
+        std::free(pointer);
+    }
+
+
+    void operator delete[](void* pointer) noexcept {
+        std::free(pointer);
+    }
+
+
+    void operator delete(void* pointer, std::size_t) noexcept {
+        std::free(pointer);
+    }
+
+
+    void operator delete[](void* pointer, std::size_t) noexcept {
+        std::free(pointer);
+    }
+
+
+    void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+        std::free(pointer);
+    }
+
+
+    void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+        std::free(pointer);
+    }
+
+#endif
+
+
+unsigned long AllocationCounter::allocations() {
+    return threadAllocations;
+}
@@ -0,0 +1,42 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides accounting of heap allocations for the allocation check.
+***********************************************************************************************************************/
+
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+/*
+ * Class that reports the number of heap allocations made by the calling thread, so the check can assert that scrubbing
+ * performs no allocations once warmed up.
+ *
+ * The counter is test instrumentation and is only built into the allocation check, never into the library.  On glibc
+ * targets, malloc, calloc, realloc, and the aligned allocation functions are replaced with versions that count calls
+ * before calling the glibc implementations.  The replacements are found by symbol interposition, so allocations made
+ * by Qt, such as QByteArray buffers, and by operator new are counted.  On other targets only the global operator new
+ * is replaced, in every form, so allocations Qt makes with malloc are not counted.
+ */
+class AllocationCounter {
+    public:
+        /*
+         * Returns the number of allocations made by the calling thread since it started.  On targets other than
+         * glibc, only calls to operator new are counted.
+         */
+        static unsigned long allocations();
+};
+#endif
@@ -0,0 +1,360 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file checks \ref HtmlScrubber::ChunkHashSink.  Chunks must tile the scrubbed output exactly, chunks after an
+* early edit must keep their boundaries and hashes, and the chunks must not depend on how the data is split between
+* calls.  Documents are generated pseudo-randomly from a fixed seed so every run checks the same input.
+***********************************************************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "html_scrubber_sink.h"
+#include "html_scrubber_engine.h"
+#include "html_scrubber_xxh64.h"
+#include "html_scrubber_chunk_hash_sink.h"
+
+#include "document_generator.h"
+
+namespace {
+    typedef HtmlScrubber::Engine               Engine;
+    typedef HtmlScrubber::Xxh64                Xxh64;
+    typedef HtmlScrubber::ChunkHashSink        ChunkHashSink;
+    typedef HtmlScrubber::ChunkHashSink::Chunk Chunk;
+
+    using DocumentGenerator::Random;
+    using DocumentGenerator::generateDocument;
+
+    /*
+     * Minimum, average, and maximum chunk lengths checked.
+     */
+    struct ChunkLengths {
+        unsigned long minimumLength;
+        unsigned long averageLength;
+        unsigned long maximumLength;
+    };
+
+    const ChunkLengths chunkLengths[] = {
+        {
+            ChunkHashSink::defaultMinimumLength,
+            ChunkHashSink::defaultAverageLength,
+            ChunkHashSink::defaultMaximumLength
+        },
+        { 32, 128, 1024 },
+        { 16, 64, 96 }
+    };
+
+    /*
+     * Sink that collects the scrubbed data.
+     */
+    class StringSink:public HtmlScrubber::Sink {
+        public:
+            void update(const char* data, unsigned long length) override {
+                output.append(data, length);
+            }
+
+            std::string output;
+    };
+
+    /*
+     * Sink that passes the scrubbed data to two other sinks.
+     */
+    class TeeSink:public HtmlScrubber::Sink {
+        public:
+            TeeSink(Sink* first, Sink* second):first(first), second(second) {}
+
+            void update(const char* data, unsigned long length) override {
+                first->update(data, length);
+                second->update(data, length);
+            }
+
+        private:
+            Sink* first;
+            Sink* second;
+    };
+
+    /*
+     * Returns a description of a set of chunk lengths.
+     */
+    std::string describe(const ChunkLengths& lengths) {
+        return (
+              std::to_string(lengths.minimumLength) + "/" + std::to_string(lengths.averageLength) + "/"
+            + std::to_string(lengths.maximumLength)
+        );
+    }
+
+    /*
+     * Returns true if two chunks have the same length and hash and their offsets differ by the given amount.
+     */
+    bool sameChunk(const Chunk& chunk, const Chunk& expected, long offsetChange = 0) {
+        return (
+               static_cast<long>(chunk.offset) == static_cast<long>(expected.offset) + offsetChange
+            && chunk.length == expected.length
+            && chunk.hash == expected.hash
+        );
+    }
+
+    /*
+     * Returns true if two lists of chunks are identical.
+     */
+    bool sameChunks(const std::vector<Chunk>& chunks, const std::vector<Chunk>& expected) {
+        bool result = chunks.size() == expected.size();
+
+        for (unsigned long index=0 ; result && index<chunks.size() ; ++index) {
+            result = sameChunk(chunks[index], expected[index]);
+        }
+
+        return result;
+    }
+
+    /*
+     * Chunks data supplied in a single call.
+     */
+    std::vector<Chunk> chunkData(const std::string& data, const ChunkLengths& lengths) {
+        ChunkHashSink sink(lengths.minimumLength, lengths.averageLength, lengths.maximumLength);
+
+        sink.update(data.data(), data.size());
+        sink.finish();
+
+        return sink.chunks();
+    }
+
+    /*
+     * Checks that the chunks of documents scrubbed by the engine tile the scrubbed output: chunks are contiguous,
+     * cover every byte, respect the length limits, and hash to the XXH64 of the bytes they cover.  Returns the number
+     * of mismatches.
+     */
+    unsigned checkTiling(unsigned long& numberChecked) {
+        static const unsigned long lengths[] = { 0, 1, 200, 5000, 40000, 150000 };
+
+        unsigned numberMismatches = 0;
+
+        for (unsigned documentIndex=0 ; documentIndex<sizeof(lengths) / sizeof(lengths[0]) ; ++documentIndex) {
+            std::string document = generateDocument<std::string>(documentIndex + 1, lengths[documentIndex], false);
+
+            for (const ChunkLengths& chunkLength : chunkLengths) {
+                std::string description = (
+                    "tiling, document " + std::to_string(documentIndex) + ", lengths " + describe(chunkLength)
+                );
+
+                StringSink    stringSink;
+                ChunkHashSink chunkSink(
+                    chunkLength.minimumLength,
+                    chunkLength.averageLength,
+                    chunkLength.maximumLength
+                );
+
+                TeeSink sink(&stringSink, &chunkSink);
+                Engine  engine(document.data(), document.size());
+
+                engine.setSink(&sink);
+                engine.scrub();
+                chunkSink.finish();
+
+                const std::string&        output = stringSink.output;
+                const std::vector<Chunk>& chunks = chunkSink.chunks();
+
+                unsigned long offset = 0;
+                bool          valid  = true;
+
+                for (unsigned long index=0 ; valid && index<chunks.size() ; ++index) {
+                    const Chunk& chunk = chunks[index];
+                    bool         last  = index + 1 == chunks.size();
+
+                    valid = (
+                           chunk.offset == offset
+                        && chunk.length > 0
+                        && chunk.length <= chunkLength.maximumLength
+                        && (last || chunk.length > chunkLength.minimumLength)
+                        && chunk.offset + chunk.length <= output.size()
+                        && chunk.hash == Xxh64::hash(output.data() + chunk.offset, chunk.length)
+                    );
+
+                    if (!valid) {
+                        std::cout << description << ": chunk " << index << " at " << chunk.offset << ", length "
+                                  << chunk.length << " is invalid" << std::endl;
+                    }
+
+                    offset += chunk.length;
+                }
+
+                if (valid && offset != output.size()) {
+                    std::cout << description << ": chunks cover " << offset << " of " << output.size() << " bytes"
+                              << std::endl;
+                    valid = false;
+                }
+
+                numberMismatches += valid ? 0 : 1;
+                ++numberChecked;
+            }
+        }
+
+        return numberMismatches;
+    }
+
+    /*
+     * Checks that an edit near the start of the scrubbed output only changes the chunks around it.  Chunks ending
+     * before the edit must be unchanged and chunks starting two maximum chunk lengths after it must keep their
+     * lengths and hashes, moved by the change in length.  Returns the number of mismatches.
+     */
+    unsigned checkEditedChunks(unsigned long& numberChecked) {
+        struct Edit {
+            unsigned long offset;
+            unsigned long removed;
+            const char*   inserted;
+        };
+
+        static const Edit edits[] = {
+            {   100,  0, "inserted text " },
+            {   100,  9, ""               },
+            {   300,  1, "Z"              },
+            {  5000, 40, "0123456789"     }
+        };
+
+        unsigned numberMismatches = 0;
+
+        for (unsigned documentIndex=0 ; documentIndex<4 ; ++documentIndex) {
+            StringSink  sink;
+            std::string document = generateDocument<std::string>(documentIndex + 50, 150000, false);
+
+            Engine      engine(document.data(), document.size());
+
+            engine.setSink(&sink);
+            engine.scrub();
+
+            const std::string& original = sink.output;
+
+            for (const ChunkLengths& chunkLength : chunkLengths) {
+                /*
+                 * A boundary forced at the maximum length moves with the edit.  Lengths where most boundaries are
+                 * forced are only checked for tiling and splitting.
+                 */
+                if (chunkLength.maximumLength < 4 * chunkLength.averageLength) {
+                    continue;
+                }
+
+                std::vector<Chunk> originalChunks = chunkData(original, chunkLength);
+
+                for (unsigned editIndex=0 ; editIndex<sizeof(edits) / sizeof(edits[0]) ; ++editIndex) {
+                    const Edit& edit   = edits[editIndex];
+                    std::string edited = std::string(original).replace(edit.offset, edit.removed, edit.inserted);
+                    long        change = static_cast<long>(edited.size()) - static_cast<long>(original.size());
+
+                    std::vector<Chunk>             editedChunks = chunkData(edited, chunkLength);
+                    std::map<unsigned long, Chunk> editedByOffset;
+                    for (const Chunk& chunk : editedChunks) {
+                        editedByOffset[chunk.offset] = chunk;
+                    }
+
+                    unsigned long stableOffset = edit.offset + edit.removed + 2 * chunkLength.maximumLength;
+                    unsigned long numberMoved  = 0;
+                    bool          valid        = true;
+
+                    for (const Chunk& originalChunk : originalChunks) {
+                        if (originalChunk.offset + originalChunk.length <= edit.offset) {
+                            auto it = editedByOffset.find(originalChunk.offset);
+                            valid = valid && it != editedByOffset.end() && sameChunk(it->second, originalChunk);
+                        } else if (originalChunk.offset >= stableOffset) {
+                            auto it = editedByOffset.find(static_cast<unsigned long>(originalChunk.offset + change));
+                            valid = valid && it != editedByOffset.end() && sameChunk(it->second, originalChunk, change);
+                            ++numberMoved;
+                        }
+                    }
+
+                    if (!valid || numberMoved == 0) {
+                        std::cout << "edited chunks, document " << documentIndex << ", lengths "
+                                  << describe(chunkLength) << ", edit " << editIndex << ": boundaries moved"
+                                  << std::endl;
+                        ++numberMismatches;
+                    }
+
+                    ++numberChecked;
+                }
+            }
+        }
+
+        return numberMismatches;
+    }
+
+    /*
+     * Checks that data fed in pieces, split at pseudo-random points or one byte at a time, yields the same chunks as
+     * data fed in one call, and that a cleared sink can be reused.  Returns the number of mismatches.
+     */
+    unsigned checkSplitFeeding(unsigned long& numberChecked) {
+        static const unsigned maximumPieces[] = { 1, 3, 17, 100, 5000 };
+
+        unsigned numberMismatches = 0;
+
+        for (unsigned documentIndex=0 ; documentIndex<4 ; ++documentIndex) {
+            std::string data = generateDocument<std::string>(documentIndex + 200, 30000, documentIndex % 2 != 0);
+
+            for (const ChunkLengths& chunkLength : chunkLengths) {
+                std::vector<Chunk> expected = chunkData(data, chunkLength);
+                ChunkHashSink      sink(
+                    chunkLength.minimumLength,
+                    chunkLength.averageLength,
+                    chunkLength.maximumLength
+                );
+
+                for (unsigned maximumPiece : maximumPieces) {
+                    Random        random(documentIndex * 7 + maximumPiece);
+                    unsigned long index = 0;
+
+                    sink.clear();
+                    while (index < data.size()) {
+                        unsigned long pieceLength = std::min<unsigned long>(
+                            1 + random.next(maximumPiece),
+                            data.size() - index
+                        );
+
+                        sink.update(data.data() + index, pieceLength);
+                        index += pieceLength;
+                    }
+
+                    sink.finish();
+
+                    if (!sameChunks(sink.chunks(), expected)) {
+                        std::cout << "split feeding, document " << documentIndex << ", lengths "
+                                  << describe(chunkLength) << ", maximum piece " << maximumPiece
+                                  << ": differs from one call" << std::endl;
+                        ++numberMismatches;
+                    }
+
+                    ++numberChecked;
+                }
+            }
+        }
+
+        return numberMismatches;
+    }
+}
+
+int main() {
+    unsigned long numberChecked    = 0;
+    unsigned      numberMismatches = 0;
+
+    numberMismatches += checkTiling(numberChecked);
+    numberMismatches += checkEditedChunks(numberChecked);
+    numberMismatches += checkSplitFeeding(numberChecked);
+
+    std::cout << numberChecked << " chunkings checked, " << numberMismatches << " mismatches" << std::endl;
+    return numberMismatches == 0 ? 0 : 1;
+}
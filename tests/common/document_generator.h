@@ -0,0 +1,93 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides the pseudo-random HTML documents shared by the checks.  Documents are generated from a fixed
+* seed so every run checks the same input.
+***********************************************************************************************************************/
+
+#ifndef DOCUMENT_GENERATOR_H
+#define DOCUMENT_GENERATOR_H
+
+#include <cstdint>
+
+namespace DocumentGenerator {
+    /*
+     * Fragments documents are built from.  Together they reach every capture mode, collapse whitespace, split
+     * keywords, and include multi-byte UTF-8 sequences.
+     */
+    static const char* const fragments[] = {
+        "<p>", "</p>", "<div class=\"main\">", "</div>", "<br/>", "<a href=\"https://inesonic.com/a?b=c\">",
+        "<a href='/relative'>", "</a>", "<img src=\"image.png\" alt=\"picture\">", "<blockquote cite=\"/quote\">",
+        "<script src=\"code.js\"></script>", "<script>if (a < b) { c = \"</p>\"; }</script>",
+        "<style>p { x: 1; }</style>",
+        "<STYLE type=\"text/css\">body > p { margin: 0 }</STYLE>", "<!-- comment <p> -->", "<!DOCTYPE html>",
+        "<?xml version=\"1.0\"?>", "<scr", "ipt>", "<sty", "le>", "<a hr", "ef=", "\"", "'", "=", "<", ">", "/",
+        "Plain text. ", "more  text\t\twith\r\nspacing ", "   ", "\n\n", "&amp; &lt; ", "caf\xC3\xA9 ",
+        "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E ", "\xF0\x9F\x98\x80 ", "x"
+    };
+
+    /*
+     * Fragments containing invalid or truncated UTF-8.
+     */
+    static const char* const invalidFragments[] = {
+        "\xC3", "\xE6\x97", "\x80", "\xFF", "\xF0\x9F\x98", "\xED\xA0\x80"
+    };
+
+    /*
+     * Pseudo-random number generator, so the documents do not depend on the standard library implementation.
+     */
+    class Random {
+        public:
+            explicit Random(std::uint32_t seed):currentValue(seed) {}
+
+            unsigned next(unsigned limit) {
+                currentValue = currentValue * 1103515245U + 12345U;
+                return static_cast<unsigned>((currentValue >> 8) % limit);
+            }
+
+        private:
+            std::uint32_t currentValue;
+    };
+
+    /*
+     * Generates a document of at least the requested length.  Invalid UTF-8 is included when requested.  The string
+     * type must provide size() and append(const char*), as std::string and QByteArray do.
+     */
+    template<typename String> String generateDocument(
+            std::uint32_t seed,
+            unsigned long length,
+            bool          includeInvalid
+        ) {
+        const unsigned numberFragments        = sizeof(fragments) / sizeof(fragments[0]);
+        const unsigned numberInvalidFragments = sizeof(invalidFragments) / sizeof(invalidFragments[0]);
+
+        Random random(seed);
+        String result;
+
+        while (static_cast<unsigned long>(result.size()) < length) {
+            if (includeInvalid && random.next(50) == 0) {
+                result.append(invalidFragments[random.next(numberInvalidFragments)]);
+            } else {
+                result.append(fragments[random.next(numberFragments)]);
+            }
+        }
+
+        return result;
+    }
+}
+
+#endif
@@ -0,0 +1,344 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file checks that the alternate ways of driving \ref HtmlScrubber::Engine generate the same output as the switch
+* back-end scrubbing the whole document.  Documents are generated pseudo-randomly from a fixed seed so every run checks
+* the same input.
+***********************************************************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "html_scrubber_sink.h"
+#include "html_scrubber_engine.h"
+#include "html_scrubber_state_map.h"
+#include "html_scrubber_utf8.h"
+
+#include "document_generator.h"
+
+namespace {
+    typedef HtmlScrubber::Engine             Engine;
+    typedef HtmlScrubber::Engine::Backend    Backend;
+    typedef HtmlScrubber::Engine::Utf8Policy Utf8Policy;
+    typedef HtmlScrubber::Engine::InputMode  InputMode;
+
+    using DocumentGenerator::Random;
+    using DocumentGenerator::generateDocument;
+
+    /*
+     * The UTF-8 policies checked.
+     */
+    const Utf8Policy utf8Policies[] = { Utf8Policy::PASS_THROUGH, Utf8Policy::REPLACE, Utf8Policy::REJECT };
+
+    /*
+     * Sink that collects the scrubbed data.
+     */
+    class StringSink:public HtmlScrubber::Sink {
+        public:
+            void update(const char* data, unsigned long length) override {
+                output.append(data, length);
+            }
+
+            std::string output;
+    };
+
+    /*
+     * Scrubs a whole document through an engine.  Returns false if the document was rejected.
+     */
+    bool scrub(const std::string& document, Backend backend, Utf8Policy policy, InputMode mode, std::string& output) {
+        StringSink sink;
+        Engine     engine(document.data(), document.size(), mode);
+
+        engine.setSink(&sink);
+        engine.setBackend(backend);
+        engine.setUtf8Policy(policy);
+
+        bool success = engine.scrub();
+        output = sink.output;
+
+        return success;
+    }
+
+    /*
+     * Compares a result against the result from the switch back-end, reporting any difference.  Returns 1 on a
+     * mismatch and 0 otherwise.
+     */
+    unsigned compare(
+            const std::string& name,
+            bool               success,
+            const std::string& output,
+            bool               expectedSuccess,
+            const std::string& expectedOutput
+        ) {
+        unsigned result = 0;
+
+        if (success != expectedSuccess || (success && output != expectedOutput)) {
+            std::cout << name << ": differs from the switch back-end" << std::endl;
+            result = 1;
+        }
+
+        return result;
+    }
+
+    /*
+     * Checks the block parallel back-end against the switch back-end for documents spanning several chunks, under
+     * every UTF-8 policy and input mode, with worker thread limits that split the documents into different numbers
+     * of chunks.  The limit is independent of the host, so the chunked path is exercised even on a single core.
+     */
+    unsigned checkParallel(unsigned long& numberChecked) {
+        static const unsigned long lengths[]      = { 600 * 1024, 1100 * 1024, 2 * 1024 * 1024 };
+        static const unsigned      threadLimits[] = { 0, 1, 3, 6 };
+
+        unsigned numberMismatches = 0;
+        unsigned originalLimit    = Engine::parallelThreadLimit();
+
+        for (unsigned documentIndex=0 ; documentIndex<6 ; ++documentIndex) {
+            bool        includeInvalid = (documentIndex % 2) != 0;
+            std::string document       = generateDocument<std::string>(
+                documentIndex + 1,
+                lengths[documentIndex / 2],
+                includeInvalid
+            );
+
+            for (Utf8Policy policy : utf8Policies) {
+                std::string expectedOutput;
+                bool        expectedSuccess = scrub(
+                    document,
+                    Backend::SWITCH,
+                    policy,
+                    InputMode::READ_ONLY,
+                    expectedOutput
+                );
+
+                for (unsigned threadLimit : threadLimits) {
+                    Engine::setParallelThreadLimit(threadLimit);
+
+                    for (InputMode mode : { InputMode::COPY, InputMode::READ_ONLY }) {
+                        std::string output;
+                        bool        success = scrub(document, Backend::PARALLEL, policy, mode, output);
+
+                        numberMismatches += compare(
+                            "parallel, document " + std::to_string(documentIndex) +
+                            ", policy " + std::to_string(static_cast<unsigned>(policy)) +
+                            ", thread limit " + std::to_string(threadLimit) +
+                            ", input mode " + std::to_string(static_cast<unsigned>(mode)),
+                            success,
+                            output,
+                            expectedSuccess,
+                            expectedOutput
+                        );
+
+                        ++numberChecked;
+                    }
+                }
+            }
+        }
+
+        Engine::setParallelThreadLimit(originalLimit);
+
+        if (!HtmlScrubber::StateMap::accelerated()) {
+            std::cout << "built without AVX-512 VBMI, the block parallel back-end was checked serially, build with "
+                      << "CONFIG+=vbmi to check the state maps" << std::endl;
+        }
+
+        return numberMismatches;
+    }
+
+    /*
+     * Checks scrubbing a document supplied in chunks against the switch back-end scrubbing the whole document, for
+     * every back-end and UTF-8 policy.  Chunks are cut at pseudo-random points, from single bytes to chunks longer
+     * than the staging buffer, so parser state, capture mode, skipped keywords, and multi-byte sequences are split
+     * at arbitrary positions.  Each chunk is copied to its own buffer that is released once it has been fed.  One
+     * engine is reused for every document so state left over from a previous document is also caught.
+     */
+    unsigned checkStreaming(unsigned long& numberChecked) {
+        static const unsigned long lengths[]        = { 1, 64, 1000, 5000, 20000, 70000 };
+        static const unsigned      maximumChunks[]  = { 1, 7, 300, 9000 };
+        static const Backend       backends[]       = { Backend::SWITCH, Backend::TABLE, Backend::PARALLEL };
+
+        unsigned numberMismatches = 0;
+        Engine   engine(nullptr, 0);
+
+        for (unsigned documentIndex=0 ; documentIndex<12 ; ++documentIndex) {
+            bool        includeInvalid = (documentIndex % 2) != 0;
+            std::string document       = generateDocument<std::string>(
+                documentIndex + 100,
+                lengths[documentIndex / 2],
+                includeInvalid
+            );
+
+            for (Utf8Policy policy : utf8Policies) {
+                std::string expectedOutput;
+                bool        expectedSuccess = scrub(
+                    document,
+                    Backend::SWITCH,
+                    policy,
+                    InputMode::READ_ONLY,
+                    expectedOutput
+                );
+
+                for (Backend backend : backends) {
+                    for (unsigned maximumChunk : maximumChunks) {
+                        Random     random(documentIndex * 31 + maximumChunk);
+                        StringSink sink;
+                        bool       success = true;
+
+                        engine.setSink(&sink);
+                        engine.setBackend(backend);
+                        engine.setUtf8Policy(policy);
+                        engine.begin();
+
+                        unsigned long index = 0;
+                        while (index < document.size()) {
+                            unsigned long chunkLength = std::min<unsigned long>(
+                                1 + random.next(maximumChunk),
+                                document.size() - index
+                            );
+
+                            std::vector<char> chunk(document.begin() + index, document.begin() + index + chunkLength);
+                            success = engine.feed(chunk.data(), chunkLength) && success;
+                            index += chunkLength;
+                        }
+
+                        success = engine.finish() && success;
+
+                        numberMismatches += compare(
+                            "streaming, document " + std::to_string(documentIndex) +
+                            ", policy " + std::to_string(static_cast<unsigned>(policy)) +
+                            ", backend " + std::to_string(static_cast<unsigned>(backend)) +
+                            ", maximum chunk " + std::to_string(maximumChunk),
+                            success,
+                            sink.output,
+                            expectedSuccess,
+                            expectedOutput
+                        );
+
+                        ++numberChecked;
+                    }
+                }
+            }
+        }
+
+        return numberMismatches;
+    }
+
+    /*
+     * Checks scrubbing in place against the switch back-end, for every back-end and UTF-8 policy, with buffers too
+     * small for the padding, exactly padded, large enough for the growth caused by replacement characters, and three
+     * times the input.  Under REPLACE the exactly padded buffer can not hold the growth, so the temporary buffer is
+     * used, and the replaced length buffer moves the input up by exactly the growth.  The scrub must succeed exactly
+     * when the expected output fits, and the buffer must be left unchanged when it does not.
+     */
+    unsigned checkInPlace(unsigned long& numberChecked) {
+        static const unsigned long lengths[]  = { 0, 40, 3000, 50000 };
+        static const Backend       backends[] = { Backend::SWITCH, Backend::TABLE, Backend::PARALLEL };
+
+        unsigned numberMismatches = 0;
+
+        for (unsigned documentIndex=0 ; documentIndex<10 ; ++documentIndex) {
+            std::string document;
+
+            if (documentIndex < 8) {
+                document = generateDocument<std::string>(
+                    documentIndex + 200,
+                    lengths[documentIndex / 2],
+                    (documentIndex % 2) != 0
+                );
+            } else {
+                /*
+                 * Text that is almost entirely invalid, so the replaced output is larger than the padded input.
+                 */
+                document = std::string(500, '\xFF') + generateDocument<std::string>(documentIndex + 200, 30, false);
+            }
+
+            unsigned long length         = document.size();
+            unsigned long replacedLength = HtmlScrubber::Utf8::replacedLength(document.data(), length);
+            unsigned long capacities[]   = {
+                length + Engine::paddingLength - 1,
+                length + Engine::paddingLength,
+                replacedLength + Engine::paddingLength,
+                3 * length + Engine::paddingLength
+            };
+
+            for (Utf8Policy policy : utf8Policies) {
+                std::string expectedOutput;
+                bool        expectedSuccess = scrub(
+                    document,
+                    Backend::SWITCH,
+                    policy,
+                    InputMode::READ_ONLY,
+                    expectedOutput
+                );
+
+                for (Backend backend : backends) {
+                    for (unsigned long capacity : capacities) {
+                        if (capacity < Engine::paddingLength) {
+                            continue;
+                        }
+
+                        std::vector<char> buffer(capacity, 'Z');
+                        std::copy(document.begin(), document.end(), buffer.begin());
+
+                        unsigned long outputLength = 0;
+                        bool          success      = Engine::scrubInPlace(
+                            buffer.data(),
+                            length,
+                            capacity,
+                            outputLength,
+                            backend,
+                            policy
+                        );
+
+                        bool        fits = capacity >= length + Engine::paddingLength &&
+                                           expectedOutput.size() <= capacity;
+                        std::string name = "in place, document " + std::to_string(documentIndex) +
+                                           ", policy " + std::to_string(static_cast<unsigned>(policy)) +
+                                           ", backend " + std::to_string(static_cast<unsigned>(backend)) +
+                                           ", capacity " + std::to_string(capacity);
+
+                        std::string output = success ? std::string(buffer.data(), outputLength) : std::string();
+                        numberMismatches += compare(name, success, output, expectedSuccess && fits, expectedOutput);
+
+                        if (!success && std::string(buffer.data(), length) != document) {
+                            std::cout << name << ": buffer modified on failure" << std::endl;
+                            ++numberMismatches;
+                        }
+
+                        ++numberChecked;
+                    }
+                }
+            }
+        }
+
+        return numberMismatches;
+    }
+}
+
+int main() {
+    unsigned long numberChecked    = 0;
+    unsigned long numberMismatches = 0;
+
+    numberMismatches += checkParallel(numberChecked);
+    numberMismatches += checkStreaming(numberChecked);
+    numberMismatches += checkInPlace(numberChecked);
+
+    std::cout << numberChecked << " scrubs checked, " << numberMismatches << " mismatches" << std::endl;
+    return numberMismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,83 @@
+##-*-makefile-*-########################################################################################################
+# Copyright 2022 - 2023 Inesonic, LLC.
+#
+# GNU Public License, Version 3:
+#   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+#   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+#   version.
+#   
+#   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+#   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+#   details.
+#   
+#   You should have received a copy of the GNU General Public License along with this program.  If not, see
+#   <https://www.gnu.org/licenses/>.
+########################################################################################################################
+
+TEMPLATE = app
+
+########################################################################################################################
+# Basic build characteristics
+#
+# Checks that the alternate ways of driving the engine generate the same output as the switch back-end.  Run with
+# "make check".
+#
+
+QT -= core gui
+CONFIG += console c++14 thread testcase
+CONFIG -= app_bundle
+
+vbmi {
+    # Checks the block parallel back-end with its state maps rather than the serial fallback.  See the vbmi option
+    # in inehtml_scrubber.pro.
+
+    gcc|clang:QMAKE_CXXFLAGS += -mavx512bw -mavx512vbmi
+}
+
+########################################################################################################################
+# Includes
+#
+
+INCLUDEPATH += ../../inehtml_scrubber/include \
+               ../../inehtml_scrubber/source \
+               ../common
+HEADERS = ../common/document_generator.h \
+          ../../inehtml_scrubber/include/html_scrubber_parser.h \
+          ../../inehtml_scrubber/include/html_scrubber_parser_table.h \
+          ../../inehtml_scrubber/include/html_scrubber_static_parser.h \
+          ../../inehtml_scrubber/include/html_scrubber_sink.h \
+          ../../inehtml_scrubber/include/html_scrubber_span_sink.h \
+          ../../inehtml_scrubber/include/html_scrubber_engine.h \
+          ../../inehtml_scrubber/source/html_scrubber_engine_step.h \
+          ../../inehtml_scrubber/source/html_scrubber_keyword_matcher.h \
+          ../../inehtml_scrubber/source/html_scrubber_scanner.h \
+          ../../inehtml_scrubber/source/html_scrubber_state_map.h \
+          ../../inehtml_scrubber/source/html_scrubber_utf8.h \
+
+########################################################################################################################
+# Source files
+#
+
+SOURCES = engine_check.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_parser_table.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_state_map.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_utf8.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_sink.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_span_sink.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_engine.cpp \
+
+########################################################################################################################
+# Locate build intermediate and output products
+#
+
+TARGET = engine_check
+
+CONFIG(debug, debug|release) {
+    unix:DESTDIR = build/debug
+    win32:DESTDIR = build/Debug
+} else {
+    unix:DESTDIR = build/release
+    win32:DESTDIR = build/Release
+}
+
+OBJECTS_DIR = $${DESTDIR}/objects
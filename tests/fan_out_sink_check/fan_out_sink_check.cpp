@@ -0,0 +1,251 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file checks that \ref HtmlScrubber::FanOutSink passes every sink the same data the sink receives when it is
+* used on its own.  A \ref HtmlScrubber::ByteArraySink, \ref HtmlScrubber::FastHashSink, and
+* \ref HtmlScrubber::CryptographicHashSink behind a fan-out sink must yield the same results as each sink used alone,
+* for every back-end and UTF-8 policy, whole and streamed.  Documents are generated pseudo-randomly from a fixed seed
+* so every run checks the same input.
+***********************************************************************************************************************/
+
+#include <QtGlobal>
+#include <QByteArray>
+#include <QCryptographicHash>
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "html_scrubber_sink.h"
+#include "html_scrubber_span_sink.h"
+#include "html_scrubber_engine.h"
+#include "html_scrubber_xxh64.h"
+#include "html_scrubber_byte_array_sink.h"
+#include "html_scrubber_fast_hash_sink.h"
+#include "html_scrubber_cryptographic_hash_sink.h"
+#include "html_scrubber_fan_out_sink.h"
+
+#include "document_generator.h"
+
+namespace {
+    typedef HtmlScrubber::Sink                  Sink;
+    typedef HtmlScrubber::Engine                Engine;
+    typedef HtmlScrubber::Engine::Backend       Backend;
+    typedef HtmlScrubber::Engine::Utf8Policy    Utf8Policy;
+    typedef HtmlScrubber::Xxh64                 Xxh64;
+    typedef HtmlScrubber::SpanSink              SpanSink;
+    typedef HtmlScrubber::ByteArraySink         ByteArraySink;
+    typedef HtmlScrubber::FastHashSink          FastHashSink;
+    typedef HtmlScrubber::CryptographicHashSink CryptographicHashSink;
+    typedef HtmlScrubber::FanOutSink            FanOutSink;
+
+    using DocumentGenerator::Random;
+    using DocumentGenerator::generateDocument;
+
+    /*
+     * The back-ends and UTF-8 policies checked.
+     */
+    const Backend    backends[]     = { Backend::SWITCH, Backend::TABLE, Backend::PARALLEL };
+    const Utf8Policy utf8Policies[] = { Utf8Policy::PASS_THROUGH, Utf8Policy::REPLACE, Utf8Policy::REJECT };
+
+    /*
+     * The largest pieces a streamed document is fed in.  Zero scrubs the whole document in one call.
+     */
+    const unsigned maximumPieces[] = { 0, 1, 7, 1000 };
+
+    /*
+     * The hash algorithm used by the cryptographic hash sinks.
+     */
+    const QCryptographicHash::Algorithm hashAlgorithm = QCryptographicHash::Sha256;
+
+    /*
+     * Scrubs a document into a sink, either whole or fed in pieces no longer than the maximum piece length.  Returns
+     * false if the document was rejected.
+     */
+    bool scrub(
+            const QByteArray& document,
+            Backend           backend,
+            Utf8Policy        policy,
+            unsigned          maximumPiece,
+            Sink*             sink
+        ) {
+        bool success;
+
+        if (maximumPiece == 0) {
+            Engine engine(document.constData(), static_cast<unsigned long>(document.size()));
+
+            engine.setSink(sink);
+            engine.setBackend(backend);
+            engine.setUtf8Policy(policy);
+
+            success = engine.scrub();
+        } else {
+            Engine        engine(nullptr, 0);
+            Random        random(maximumPiece);
+            unsigned long size  = static_cast<unsigned long>(document.size());
+            unsigned long index = 0;
+
+            engine.setSink(sink);
+            engine.setBackend(backend);
+            engine.setUtf8Policy(policy);
+            engine.begin();
+
+            success = true;
+            while (index < size) {
+                unsigned long pieceLength = std::min<unsigned long>(1 + random.next(maximumPiece), size - index);
+                std::vector<char> piece(document.constData() + index, document.constData() + index + pieceLength);
+
+                success = engine.feed(piece.data(), pieceLength) && success;
+                index  += pieceLength;
+            }
+
+            success = engine.finish() && success;
+        }
+
+        return success;
+    }
+
+    /*
+     * Checks a document under one back-end, policy, and feed.  The sinks are run behind a fan-out sink and then each
+     * on its own.  When the document is scrubbed whole, a span sink is added to the fan-out sink, which disables
+     * staging for every sink behind it.  Returns the number of mismatches.
+     */
+    unsigned checkDocument(
+            const std::string& name,
+            const QByteArray&  document,
+            Backend            backend,
+            Utf8Policy         policy,
+            unsigned           maximumPiece
+        ) {
+        unsigned numberMismatches = 0;
+
+        ByteArraySink         byteArraySink;
+        FastHashSink          fastHashSink;
+        CryptographicHashSink cryptographicHashSink(hashAlgorithm);
+        SpanSink              spanSink;
+        FanOutSink            fanOutSink;
+
+        fanOutSink.addSink(&byteArraySink);
+        fanOutSink.addSink(&fastHashSink);
+        fanOutSink.addSink(&cryptographicHashSink);
+
+        if (maximumPiece == 0) {
+            fanOutSink.addSink(&spanSink);
+        }
+
+        bool fanOutSuccess = scrub(document, backend, policy, maximumPiece, &fanOutSink);
+
+        ByteArraySink         aloneByteArraySink;
+        FastHashSink          aloneFastHashSink;
+        CryptographicHashSink aloneCryptographicHashSink(hashAlgorithm);
+
+        bool byteArraySuccess         = scrub(document, backend, policy, maximumPiece, &aloneByteArraySink);
+        bool fastHashSuccess          = scrub(document, backend, policy, maximumPiece, &aloneFastHashSink);
+        bool cryptographicHashSuccess = scrub(document, backend, policy, maximumPiece, &aloneCryptographicHashSink);
+
+        if (fanOutSuccess != byteArraySuccess                ||
+            fanOutSuccess != fastHashSuccess                 ||
+            fanOutSuccess != cryptographicHashSuccess           ) {
+            std::cout << name << ": fan-out sink " << (fanOutSuccess ? "accepted" : "rejected") << " the document"
+                      << " but a sink alone did not" << std::endl;
+            ++numberMismatches;
+        }
+
+        if (byteArraySink.data() != aloneByteArraySink.data()) {
+            std::cout << name << ": byte array sink data differs" << std::endl;
+            ++numberMismatches;
+        }
+
+        if (fastHashSink.result() != aloneFastHashSink.result()) {
+            std::cout << name << ": fast hash sink result differs" << std::endl;
+            ++numberMismatches;
+        }
+
+        if (cryptographicHashSink.result() != aloneCryptographicHashSink.result()) {
+            std::cout << name << ": cryptographic hash sink result differs" << std::endl;
+            ++numberMismatches;
+        }
+
+        if (maximumPiece == 0) {
+            std::vector<char> spanData(spanSink.length());
+            spanSink.copyTo(spanData.data());
+
+            if (QByteArray(spanData.data(), static_cast<int>(spanData.size())) != aloneByteArraySink.data()) {
+                std::cout << name << ": span sink data differs" << std::endl;
+                ++numberMismatches;
+            }
+        }
+
+        /*
+         * The sinks used alone must also agree with each other, so that a sink which dropped data in both runs is
+         * still caught.
+         */
+        const QByteArray& output = aloneByteArraySink.data();
+
+        QCryptographicHash expectedHash(hashAlgorithm);
+        expectedHash.addData(output.constData(), output.size());
+
+        if (aloneFastHashSink.result() != Xxh64::hash(output.constData(), static_cast<unsigned long>(output.size())) ||
+            aloneCryptographicHashSink.result() != expectedHash.result()                                          ) {
+            std::cout << name << ": hash sinks disagree with the byte array sink" << std::endl;
+            ++numberMismatches;
+        }
+
+        return numberMismatches;
+    }
+}
+
+int main() {
+    static const unsigned long lengths[] = { 0, 1, 150, 3000, 40000 };
+
+    unsigned long numberChecked    = 0;
+    unsigned      numberMismatches = 0;
+
+    for (unsigned documentIndex=0 ; documentIndex<2 * sizeof(lengths) / sizeof(lengths[0]) ; ++documentIndex) {
+        bool       includeInvalid = (documentIndex % 2) != 0;
+        QByteArray document       = generateDocument<QByteArray>(
+            documentIndex + 400,
+            lengths[documentIndex / 2],
+            includeInvalid
+        );
+
+        for (Backend backend : backends) {
+            for (Utf8Policy policy : utf8Policies) {
+                for (unsigned maximumPiece : maximumPieces) {
+                    numberMismatches += checkDocument(
+                        "document " + std::to_string(documentIndex) +
+                        ", backend " + std::to_string(static_cast<unsigned>(backend)) +
+                        ", policy " + std::to_string(static_cast<unsigned>(policy)) +
+                        ", maximum piece " + std::to_string(maximumPiece),
+                        document,
+                        backend,
+                        policy,
+                        maximumPiece
+                    );
+
+                    ++numberChecked;
+                }
+            }
+        }
+    }
+
+    std::cout << numberChecked << " documents checked, " << numberMismatches << " mismatches, Qt " << qVersion()
+              << std::endl;
+    return numberMismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+##-*-makefile-*-########################################################################################################
+# Copyright 2022 - 2023 Inesonic, LLC.
+#
+# GNU Public License, Version 3:
+#   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+#   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+#   version.
+#   
+#   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+#   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+#   details.
+#   
+#   You should have received a copy of the GNU General Public License along with this program.  If not, see
+#   <https://www.gnu.org/licenses/>.
+########################################################################################################################
+
+TEMPLATE = app
+
+########################################################################################################################
+# Basic build characteristics
+#
+# Checks that sinks behind HtmlScrubber::FanOutSink yield the same results as the sinks used alone.  Run with
+# "make check".
+#
+
+QT += core
+QT -= gui
+CONFIG += console c++14 thread testcase
+CONFIG -= app_bundle
+
+########################################################################################################################
+# Includes
+#
+
+INCLUDEPATH += ../../inehtml_scrubber/include \
+               ../../inehtml_scrubber/source \
+               ../common
+HEADERS = ../common/document_generator.h \
+          ../../inehtml_scrubber/include/html_scrubber_parser.h \
+          ../../inehtml_scrubber/include/html_scrubber_parser_table.h \
+          ../../inehtml_scrubber/include/html_scrubber_static_parser.h \
+          ../../inehtml_scrubber/include/html_scrubber_sink.h \
+          ../../inehtml_scrubber/include/html_scrubber_span_sink.h \
+          ../../inehtml_scrubber/include/html_scrubber_engine.h \
+          ../../inehtml_scrubber/include/html_scrubber_xxh64.h \
+          ../../inehtml_scrubber/include/html_scrubber_byte_array_sink.h \
+          ../../inehtml_scrubber/include/html_scrubber_fast_hash_sink.h \
+          ../../inehtml_scrubber/include/html_scrubber_cryptographic_hash_sink.h \
+          ../../inehtml_scrubber/include/html_scrubber_fan_out_sink.h \
+          ../../inehtml_scrubber/source/html_scrubber_engine_step.h \
+          ../../inehtml_scrubber/source/html_scrubber_keyword_matcher.h \
+          ../../inehtml_scrubber/source/html_scrubber_scanner.h \
+          ../../inehtml_scrubber/source/html_scrubber_state_map.h \
+          ../../inehtml_scrubber/source/html_scrubber_utf8.h \
+
+########################################################################################################################
+# Source files
+#
+
+SOURCES = fan_out_sink_check.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_parser_table.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_state_map.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_utf8.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_sink.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_span_sink.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_engine.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_xxh64.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_byte_array_sink.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_fast_hash_sink.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_cryptographic_hash_sink.cpp \
+          ../../inehtml_scrubber/source/html_scrubber_fan_out_sink.cpp \
+
+########################################################################################################################
+# Locate build intermediate and output products
+#
+
+TARGET = fan_out_sink_check
+
+CONFIG(debug, debug|release) {
+    unix:DESTDIR = build/debug
+    win32:DESTDIR = build/Debug
+} else {
+    unix:DESTDIR = build/release
+    win32:DESTDIR = build/Release
+}
+
+OBJECTS_DIR = $${DESTDIR}/objects
+MOC_DIR = $${DESTDIR}/moc
@@ -0,0 +1,200 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file checks that documents written to \ref HtmlScrubber::HashingDevice in several writes hash the same as
+* \ref HtmlScrubber::Hasher::scrubAndHash applied to the whole document.  Documents are generated pseudo-randomly from
+* a fixed seed so every run checks the same input.
+***********************************************************************************************************************/
+
+#include <QtGlobal>
+#include <QByteArray>
+#include <QCryptographicHash>
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "html_scrubber_hasher.h"
+#include "html_scrubber_hashing_device.h"
+
+#include "document_generator.h"
+
+namespace {
+    typedef HtmlScrubber::Hasher             Hasher;
+    typedef HtmlScrubber::HashingDevice      HashingDevice;
+    typedef HtmlScrubber::Hasher::Backend    Backend;
+    typedef HtmlScrubber::Hasher::Utf8Policy Utf8Policy;
+
+    using DocumentGenerator::Random;
+    using DocumentGenerator::generateDocument;
+
+    /*
+     * The hashing algorithm used throughout.
+     */
+    const QCryptographicHash::Algorithm algorithm = QCryptographicHash::Sha256;
+
+    /*
+     * The UTF-8 policies checked.
+     */
+    const Utf8Policy utf8Policies[] = { Utf8Policy::PASS_THROUGH, Utf8Policy::REPLACE, Utf8Policy::REJECT };
+
+    /*
+     * The parser back-ends checked.
+     */
+    const Backend backends[] = { Backend::SWITCH, Backend::TABLE, Backend::PARALLEL };
+
+    /*
+     * Writes a document to the device in pieces cut at pseudo-random points no longer than the maximum piece length.
+     * Returns false if any write failed.
+     */
+    bool writeDocument(HashingDevice& device, const QByteArray& document, unsigned maximumPiece, std::uint32_t seed) {
+        Random random(seed);
+        bool   success = true;
+        int    index   = 0;
+        int    size    = static_cast<int>(document.size());
+
+        while (index < size) {
+            int pieceLength = std::min(1 + static_cast<int>(random.next(maximumPiece)), size - index);
+
+            if (device.write(document.constData() + index, pieceLength) != pieceLength) {
+                success = false;
+            }
+
+            index += pieceLength;
+        }
+
+        return success;
+    }
+
+    /*
+     * Checks documents written in pieces, for every back-end and UTF-8 policy, against the hash of the whole
+     * document.  One device is reopened for every document so state left over from a previous document is also
+     * caught.
+     */
+    unsigned checkPieces(unsigned long& numberChecked) {
+        static const unsigned long lengths[]       = { 1, 100, 3000, 70000 };
+        static const unsigned      maximumPieces[] = { 1, 5, 700, 20000 };
+
+        unsigned      numberMismatches = 0;
+        HashingDevice device(algorithm);
+
+        for (unsigned documentIndex=0 ; documentIndex<8 ; ++documentIndex) {
+            bool       includeInvalid = (documentIndex % 2) != 0;
+            QByteArray document       = generateDocument<QByteArray>(
+                documentIndex + 1,
+                lengths[documentIndex / 2],
+                includeInvalid
+            );
+
+            for (Utf8Policy policy : utf8Policies) {
+                QByteArray expectedHash = Hasher::scrubAndHash(document, algorithm, Backend::SWITCH, policy);
+
+                for (Backend backend : backends) {
+                    for (unsigned maximumPiece : maximumPieces) {
+                        device.setBackend(backend);
+                        device.setUtf8Policy(policy);
+                        device.open(QIODevice::WriteOnly);
+
+                        bool written = writeDocument(device, document, maximumPiece, documentIndex + maximumPiece);
+                        device.close();
+
+                        if (device.result() != expectedHash || (!written && !expectedHash.isEmpty())) {
+                            std::cout << "pieces, document " << documentIndex
+                                      << ", policy " << static_cast<unsigned>(policy)
+                                      << ", backend " << static_cast<unsigned>(backend)
+                                      << ", maximum piece " << maximumPiece
+                                      << ": differs from the whole document hash" << std::endl;
+                            ++numberMismatches;
+                        }
+
+                        ++numberChecked;
+                    }
+                }
+            }
+        }
+
+        return numberMismatches;
+    }
+
+    /*
+     * Checks that changing the back-end and UTF-8 policy while a document is being written only affects the next
+     * document.
+     */
+    unsigned checkSettingsLatched(unsigned long& numberChecked) {
+        unsigned      numberMismatches = 0;
+        HashingDevice device(algorithm);
+        QByteArray    document         = generateDocument<QByteArray>(50, 5000, true);
+        int           half             = document.size() / 2;
+
+        QByteArray    passThroughHash  = Hasher::scrubAndHash(
+            document,
+            algorithm,
+            Backend::SWITCH,
+            Utf8Policy::PASS_THROUGH
+        );
+        QByteArray    replaceHash      = Hasher::scrubAndHash(
+            document,
+            algorithm,
+            Backend::SWITCH,
+            Utf8Policy::REPLACE
+        );
+
+        device.setUtf8Policy(Utf8Policy::PASS_THROUGH);
+        device.open(QIODevice::WriteOnly);
+        device.write(document.constData(), half);
+
+        device.setUtf8Policy(Utf8Policy::REPLACE);
+        device.setBackend(Backend::TABLE);
+        device.write(document.constData() + half, document.size() - half);
+        device.close();
+
+        if (device.result() != passThroughHash) {
+            std::cout << "latched settings: policy changed part way through a document" << std::endl;
+            ++numberMismatches;
+        }
+
+        if (device.utf8Policy() != Utf8Policy::REPLACE || device.backend() != Backend::TABLE) {
+            std::cout << "latched settings: selected settings not reported" << std::endl;
+            ++numberMismatches;
+        }
+
+        device.open(QIODevice::WriteOnly);
+        device.write(document);
+        device.close();
+
+        if (device.result() != replaceHash) {
+            std::cout << "latched settings: policy not applied when reopened" << std::endl;
+            ++numberMismatches;
+        }
+
+        numberChecked += 2;
+        return numberMismatches;
+    }
+}
+
+int main() {
+    unsigned long numberChecked    = 0;
+    unsigned      numberMismatches = 0;
+
+    numberMismatches += checkPieces(numberChecked);
+    numberMismatches += checkSettingsLatched(numberChecked);
+
+    std::cout << numberChecked << " documents checked, " << numberMismatches << " mismatches, Qt " << qVersion()
+              << std::endl;
+    return numberMismatches == 0 ? 0 : 1;
+}
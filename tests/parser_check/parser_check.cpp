@@ -0,0 +1,347 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file checks that the switch and table back-ends of \ref HtmlScrubber::StaticParser, and
+* \ref HtmlScrubber::ParserTable, match the ypg generated \ref HtmlScrubber::Parser for every state and every byte the
+* engine passes to the parser.
+***********************************************************************************************************************/
+
+#include <deque>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "html_scrubber_parser.h"
+#include "html_scrubber_parser_table.h"
+#include "html_scrubber_static_parser.h"
+
+namespace {
+    typedef HtmlScrubber::ParserTable       ParserTable;
+    typedef HtmlScrubber::Parser::States    States;
+    typedef HtmlScrubber::ParserTable::Hook Hook;
+
+    /*
+     * The number of byte values checked.  The engine only passes ASCII bytes to the parser.
+     */
+    const unsigned numberBytes = 128;
+
+    /*
+     * Parser that records the transition method triggered by each byte.
+     */
+    class RecordingParser:public HtmlScrubber::Parser {
+        public:
+            RecordingParser():lastHook(Hook::NONE) {}
+
+            void run(const std::string& path) {
+                reset();
+
+                for (char c : path) {
+                    parse(c);
+                }
+            }
+
+            States step(char c, Hook& hook) {
+                lastHook = Hook::NONE;
+                parse(c);
+
+                hook = lastHook;
+                return state();
+            }
+
+        protected:
+            void startTag(States /* oldState */, States /* newState */, char& /* c */) override {
+                lastHook = Hook::START_TAG;
+            }
+
+            void multipleWhiteSpace(States /* oldState */, States /* newState */, char& /* c */) override {
+                lastHook = Hook::MULTIPLE_WHITE_SPACE;
+            }
+
+            void resumeText(States /* oldState */, States /* newState */, char& /* c */) override {
+                lastHook = Hook::RESUME_TEXT;
+            }
+
+            void whitespace(States /* oldState */, States /* newState */, char& /* c */) override {
+                lastHook = Hook::WHITESPACE;
+            }
+
+            void endTag(States /* oldState */, States /* newState */, char& /* c */) override {
+                lastHook = Hook::END_TAG;
+            }
+
+            void startSrcAttribute(States /* oldState */, States /* newState */, char& /* c */) override {
+                lastHook = Hook::START_SRC_ATTRIBUTE;
+            }
+
+            void endSrcAttribute(States /* oldState */, States /* newState */, char& /* c */) override {
+                lastHook = Hook::END_SRC_ATTRIBUTE;
+            }
+
+            void startHrefAttribute(States /* oldState */, States /* newState */, char& /* c */) override {
+                lastHook = Hook::START_HREF_ATTRIBUTE;
+            }
+
+            void endHrefAttribute(States /* oldState */, States /* newState */, char& /* c */) override {
+                lastHook = Hook::END_HREF_ATTRIBUTE;
+            }
+
+            void startCiteAttribute(States /* oldState */, States /* newState */, char& /* c */) override {
+                lastHook = Hook::START_CITE_ATTRIBUTE;
+            }
+
+            void endCiteAttribute(States /* oldState */, States /* newState */, char& /* c */) override {
+                lastHook = Hook::END_CITE_ATTRIBUTE;
+            }
+
+            void startScriptSrcAttribute(States /* oldState */, States /* newState */, char& /* c */) override {
+                lastHook = Hook::START_SCRIPT_SRC_ATTRIBUTE;
+            }
+
+            void endScriptSrcAttribute(States /* oldState */, States /* newState */, char& /* c */) override {
+                lastHook = Hook::END_SCRIPT_SRC_ATTRIBUTE;
+            }
+
+            void startStyle(States /* oldState */, States /* newState */, char& /* c */) override {
+                lastHook = Hook::START_STYLE;
+            }
+
+            void endStyle(States /* oldState */, States /* newState */, char& /* c */) override {
+                lastHook = Hook::END_STYLE;
+            }
+
+        private:
+            Hook lastHook;
+    };
+
+    /*
+     * Statically dispatched parser that records the transition method triggered by each byte.
+     */
+    class RecordingStaticParser:public HtmlScrubber::StaticParser<RecordingStaticParser> {
+        friend class HtmlScrubber::StaticParser<RecordingStaticParser>;
+
+        public:
+            RecordingStaticParser():lastHook(Hook::NONE) {}
+
+            States step(States fromState, char c, bool useTable, Hook& hook) {
+                setState(fromState);
+                lastHook = Hook::NONE;
+
+                if (useTable) {
+                    parseTable(c);
+                } else {
+                    parse(c);
+                }
+
+                hook = lastHook;
+                return state();
+            }
+
+        private:
+            void startTag(States /* oldState */, States /* newState */, char& /* c */) {
+                lastHook = Hook::START_TAG;
+            }
+
+            void multipleWhiteSpace(States /* oldState */, States /* newState */, char& /* c */) {
+                lastHook = Hook::MULTIPLE_WHITE_SPACE;
+            }
+
+            void resumeText(States /* oldState */, States /* newState */, char& /* c */) {
+                lastHook = Hook::RESUME_TEXT;
+            }
+
+            void whitespace(States /* oldState */, States /* newState */, char& /* c */) {
+                lastHook = Hook::WHITESPACE;
+            }
+
+            void endTag(States /* oldState */, States /* newState */, char& /* c */) {
+                lastHook = Hook::END_TAG;
+            }
+
+            void startSrcAttribute(States /* oldState */, States /* newState */, char& /* c */) {
+                lastHook = Hook::START_SRC_ATTRIBUTE;
+            }
+
+            void endSrcAttribute(States /* oldState */, States /* newState */, char& /* c */) {
+                lastHook = Hook::END_SRC_ATTRIBUTE;
+            }
+
+            void startHrefAttribute(States /* oldState */, States /* newState */, char& /* c */) {
+                lastHook = Hook::START_HREF_ATTRIBUTE;
+            }
+
+            void endHrefAttribute(States /* oldState */, States /* newState */, char& /* c */) {
+                lastHook = Hook::END_HREF_ATTRIBUTE;
+            }
+
+            void startCiteAttribute(States /* oldState */, States /* newState */, char& /* c */) {
+                lastHook = Hook::START_CITE_ATTRIBUTE;
+            }
+
+            void endCiteAttribute(States /* oldState */, States /* newState */, char& /* c */) {
+                lastHook = Hook::END_CITE_ATTRIBUTE;
+            }
+
+            void startScriptSrcAttribute(States /* oldState */, States /* newState */, char& /* c */) {
+                lastHook = Hook::START_SCRIPT_SRC_ATTRIBUTE;
+            }
+
+            void endScriptSrcAttribute(States /* oldState */, States /* newState */, char& /* c */) {
+                lastHook = Hook::END_SCRIPT_SRC_ATTRIBUTE;
+            }
+
+            void startStyle(States /* oldState */, States /* newState */, char& /* c */) {
+                lastHook = Hook::START_STYLE;
+            }
+
+            void endStyle(States /* oldState */, States /* newState */, char& /* c */) {
+                lastHook = Hook::END_STYLE;
+            }
+
+            Hook lastHook;
+    };
+
+    /*
+     * Finds the shortest input that drives the generated parser from its initial state into each state.  The
+     * generated parser can not be placed in an arbitrary state directly.  States that can not be reached are left
+     * with an empty path and flagged as unreachable.
+     */
+    void findPaths(std::vector<std::string>& paths, std::vector<bool>& reachable) {
+        RecordingParser    parser;
+        std::deque<States> pending;
+
+        paths.assign(ParserTable::numberStates, std::string());
+        reachable.assign(ParserTable::numberStates, false);
+
+        reachable[static_cast<unsigned>(States::IN_TEXT_SPACE)] = true;
+        pending.push_back(States::IN_TEXT_SPACE);
+
+        while (!pending.empty()) {
+            States state = pending.front();
+            pending.pop_front();
+
+            for (unsigned value=0 ; value<numberBytes ; ++value) {
+                Hook hook;
+                parser.run(paths[static_cast<unsigned>(state)]);
+                States next = parser.step(static_cast<char>(value), hook);
+
+                if (!reachable[static_cast<unsigned>(next)]) {
+                    std::string path = paths[static_cast<unsigned>(state)];
+                    path.push_back(static_cast<char>(value));
+
+                    reachable[static_cast<unsigned>(next)] = true;
+                    paths[static_cast<unsigned>(next)]     = path;
+                    pending.push_back(next);
+                }
+            }
+        }
+    }
+
+    /*
+     * Compares a transition against the transition taken by the generated parser, reporting any difference.  Returns
+     * 1 on a mismatch and 0 otherwise.
+     */
+    unsigned compare(
+            const char* name,
+            unsigned    stateIndex,
+            unsigned    value,
+            States      state,
+            Hook        hook,
+            States      parserState,
+            Hook        parserHook
+        ) {
+        unsigned result = 0;
+
+        if (state != parserState || hook != parserHook) {
+            std::cout << "state " << stateIndex << ", byte " << value << ": " << name << " gives state "
+                      << static_cast<unsigned>(state) << " hook " << static_cast<unsigned>(hook)
+                      << ", parser gives state " << static_cast<unsigned>(parserState) << " hook "
+                      << static_cast<unsigned>(parserHook) << std::endl;
+
+            result = 1;
+        }
+
+        return result;
+    }
+}
+
+int main() {
+    std::vector<std::string> paths;
+    std::vector<bool>        reachable;
+    RecordingParser          parser;
+    RecordingStaticParser    staticParser;
+    unsigned long            numberChecked    = 0;
+    unsigned long            numberMismatches = 0;
+
+    findPaths(paths, reachable);
+
+    for (unsigned stateIndex=0 ; stateIndex<ParserTable::numberStates ; ++stateIndex) {
+        States state = static_cast<States>(stateIndex);
+
+        if (!reachable[stateIndex]) {
+            std::cout << "state " << stateIndex << " is not reachable and was not checked" << std::endl;
+            ++numberMismatches;
+        } else {
+            for (unsigned value=0 ; value<numberBytes ; ++value) {
+                char c = static_cast<char>(value);
+
+                Hook parserHook;
+                parser.run(paths[stateIndex]);
+                States parserState = parser.step(c, parserHook);
+
+                const ParserTable::Transition& transition = ParserTable::transition(state, c);
+                numberMismatches += compare(
+                    "table",
+                    stateIndex,
+                    value,
+                    static_cast<States>(transition.nextState),
+                    transition.hook,
+                    parserState,
+                    parserHook
+                );
+
+                Hook   switchHook;
+                States switchState = staticParser.step(state, c, false, switchHook);
+                numberMismatches += compare(
+                    "static parser switch",
+                    stateIndex,
+                    value,
+                    switchState,
+                    switchHook,
+                    parserState,
+                    parserHook
+                );
+
+                Hook   tableHook;
+                States tableState = staticParser.step(state, c, true, tableHook);
+                numberMismatches += compare(
+                    "static parser table",
+                    stateIndex,
+                    value,
+                    tableState,
+                    tableHook,
+                    parserState,
+                    parserHook
+                );
+
+                ++numberChecked;
+            }
+        }
+    }
+
+    std::cout << numberChecked << " (state, byte) pairs checked, " << numberMismatches << " mismatches" << std::endl;
+    return numberMismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,186 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file checks that \ref HtmlScrubber::Scrubber keeps its output buffer, and a caller supplied output buffer, across
+* documents, as Qt 5 releases the buffer of a QByteArray resized to zero unless capacity has been reserved.  A larger
+* document is scrubbed before smaller ones so a buffer that was released and reallocated shows up as a smaller
+* capacity even if the allocator returns the same address.
+***********************************************************************************************************************/
+
+#include <QtGlobal>
+#include <QByteArray>
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "html_scrubber_scrubber.h"
+
+#include "document_generator.h"
+
+namespace {
+    typedef HtmlScrubber::Scrubber            Scrubber;
+    typedef HtmlScrubber::Scrubber::InputMode InputMode;
+
+    using DocumentGenerator::generateDocument;
+
+    /*
+     * Compares a buffer against the buffer and output expected, reporting any difference.  Returns 1 on a mismatch
+     * and 0 otherwise.
+     */
+    unsigned compareBuffer(
+            const std::string& name,
+            const QByteArray&  buffer,
+            const char*        expectedData,
+            int                expectedCapacity,
+            const QByteArray&  expectedOutput
+        ) {
+        unsigned result = 0;
+
+        if (buffer != expectedOutput) {
+            std::cout << name << ": output differs from Scrubber::scrub" << std::endl;
+            result = 1;
+        } else if (buffer.constData() != expectedData || buffer.capacity() != expectedCapacity) {
+            std::cout << name << ": output buffer reallocated, capacity " << expectedCapacity << " became "
+                      << buffer.capacity() << std::endl;
+            result = 1;
+        }
+
+        return result;
+    }
+
+    /*
+     * Checks that scrubbing the same document twice reuses the output buffer.
+     */
+    unsigned checkRepeatedScrub(unsigned long& numberChecked) {
+        QByteArray document = generateDocument<QByteArray>(1, 20000, false);
+        Scrubber   scrubber(document, InputMode::READ_ONLY);
+
+        scrubber.scrub();
+        const char* data     = scrubber.output().constData();
+        int         capacity = scrubber.output().capacity();
+
+        scrubber.scrub();
+
+        ++numberChecked;
+        return compareBuffer("repeated scrub", scrubber.output(), data, capacity, Scrubber::scrub(document));
+    }
+
+    /*
+     * Checks that one scrubber rebound to a series of documents, no larger than the first, in every input mode,
+     * reuses the output buffer for each of them.
+     */
+    unsigned checkSetInput(unsigned long& numberChecked) {
+        unsigned   numberMismatches = 0;
+        QByteArray firstDocument    = generateDocument<QByteArray>(10, 40000, false);
+        Scrubber   scrubber(firstDocument, InputMode::READ_ONLY);
+
+        scrubber.scrub();
+        const char* data     = scrubber.output().constData();
+        int         capacity = scrubber.output().capacity();
+
+        for (unsigned documentIndex=0 ; documentIndex<12 ; ++documentIndex) {
+            QByteArray  document = generateDocument<QByteArray>(
+                documentIndex + 11,
+                (documentIndex * 3001) % 30000,
+                false
+            );
+            std::string name     = "set input, document " + std::to_string(documentIndex);
+
+            switch (documentIndex % 3) {
+                case 0: {
+                    scrubber.setInput(document, InputMode::COPY);
+                    name += ", copy";
+                    break;
+                }
+
+                case 1: {
+                    scrubber.setInput(document, InputMode::READ_ONLY);
+                    name += ", read only";
+                    break;
+                }
+
+                default: {
+                    scrubber.setInput(document.constData(), static_cast<unsigned long>(document.size()));
+                    name += ", raw data";
+                    break;
+                }
+            }
+
+            scrubber.scrub();
+            numberMismatches += compareBuffer(name, scrubber.output(), data, capacity, Scrubber::scrub(document));
+
+            ++numberChecked;
+        }
+
+        return numberMismatches;
+    }
+
+    /*
+     * Checks that scrubbing a smaller document into a caller supplied buffer reuses the buffer.
+     */
+    unsigned checkCallerBuffer(unsigned long& numberChecked) {
+        QByteArray largeDocument = generateDocument<QByteArray>(2, 40000, false);
+        QByteArray smallDocument = generateDocument<QByteArray>(3, 500, false);
+        QByteArray output;
+
+        Scrubber::scrub(largeDocument, output);
+        const char* data     = output.constData();
+        int         capacity = output.capacity();
+
+        Scrubber::scrub(smallDocument, output);
+
+        ++numberChecked;
+        return compareBuffer("caller buffer", output, data, capacity, Scrubber::scrub(smallDocument));
+    }
+
+    /*
+     * Checks that a smaller document supplied in chunks after a larger one reuses the output buffer.
+     */
+    unsigned checkStreamed(unsigned long& numberChecked) {
+        QByteArray largeDocument = generateDocument<QByteArray>(4, 40000, false);
+        QByteArray smallDocument = generateDocument<QByteArray>(5, 500, false);
+        Scrubber   scrubber;
+
+        scrubber.begin();
+        scrubber.feed(largeDocument.constData(), static_cast<unsigned long>(largeDocument.size()));
+        scrubber.finish();
+
+        const char* data     = scrubber.output().constData();
+        int         capacity = scrubber.output().capacity();
+
+        scrubber.begin();
+        scrubber.feed(smallDocument.constData(), static_cast<unsigned long>(smallDocument.size()));
+        scrubber.finish();
+
+        ++numberChecked;
+        return compareBuffer("streamed", scrubber.output(), data, capacity, Scrubber::scrub(smallDocument));
+    }
+}
+
+int main() {
+    unsigned long numberChecked    = 0;
+    unsigned      numberMismatches = 0;
+
+    numberMismatches += checkRepeatedScrub(numberChecked);
+    numberMismatches += checkSetInput(numberChecked);
+    numberMismatches += checkCallerBuffer(numberChecked);
+    numberMismatches += checkStreamed(numberChecked);
+
+    std::cout << numberChecked << " checks, " << numberMismatches << " mismatches, Qt " << qVersion() << std::endl;
+    return numberMismatches == 0 ? 0 : 1;
+}
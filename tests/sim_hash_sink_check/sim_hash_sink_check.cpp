@@ -0,0 +1,275 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file checks \ref HtmlScrubber::SimHashSink.  Fingerprints must match known values, near duplicate documents
+* must have fingerprints within a small Hamming distance while unrelated documents do not, and fingerprints must not
+* depend on how the data is split between calls.
+***********************************************************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "html_scrubber_sink.h"
+#include "html_scrubber_sim_hash_sink.h"
+
+#include "document_generator.h"
+
+namespace {
+    typedef HtmlScrubber::SimHashSink SimHashSink;
+
+    using DocumentGenerator::Random;
+    using DocumentGenerator::generateDocument;
+
+    /*
+     * A known fingerprint.  The values were calculated by a separate implementation of the documented algorithm.
+     */
+    struct KnownFingerprint {
+        const char*   text;
+        unsigned      shingleLength;
+        std::uint64_t fingerprint;
+    };
+
+    const KnownFingerprint knownFingerprints[] = {
+        { "",                                                           3, 0x0000000000000000ULL },
+        { " \t\r\n ",                                                   3, 0x0000000000000000ULL },
+        { "scrubbed",                                                   3, 0x1735B04502A593E6ULL },
+        { "scrubbed page",                                              3, 0xCD7E489F9380E2B4ULL },
+        { "The quick brown fox jumps over the lazy dog.",               3, 0x9F832115C1236C89ULL },
+        { "The quick brown fox jumps over the lazy dog.",               1, 0x5C905B024E686614ULL },
+        { "  The quick\tbrown fox\r\njumps over\x7Fthe lazy dog.  ",    3, 0x9F832115C1236C89ULL },
+        {
+            "caf\xC3\xA9 \xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E \xF0\x9F\x98\x80 text",
+            2,
+            0x3AC653A8FFBF3E3CULL
+        }
+    };
+
+    /*
+     * The largest Hamming distance accepted between near duplicates, and the smallest accepted between unrelated
+     * documents.
+     */
+    const unsigned maximumNearDistance      = 8;
+    const unsigned minimumUnrelatedDistance = 16;
+
+    /*
+     * Calculates the fingerprint of data supplied in a single call.
+     */
+    std::uint64_t fingerprint(const std::string& data, unsigned shingleLength = SimHashSink::defaultShingleLength) {
+        SimHashSink sink(shingleLength);
+
+        sink.update(data.data(), data.size());
+        sink.finish();
+
+        return sink.result();
+    }
+
+    /*
+     * Generates text of pseudo-random words separated by single spaces.
+     */
+    std::vector<std::string> generateWords(std::uint32_t seed, unsigned numberWords) {
+        Random                   random(seed);
+        std::vector<std::string> result;
+
+        for (unsigned wordIndex=0 ; wordIndex<numberWords ; ++wordIndex) {
+            unsigned    length = 2 + random.next(8);
+            std::string word;
+
+            for (unsigned index=0 ; index<length ; ++index) {
+                word.push_back(static_cast<char>('a' + random.next(26)));
+            }
+
+            result.push_back(word);
+        }
+
+        return result;
+    }
+
+    /*
+     * Joins words into text.
+     */
+    std::string join(const std::vector<std::string>& words) {
+        std::string result;
+
+        for (const std::string& word : words) {
+            if (!result.empty()) {
+                result.push_back(' ');
+            }
+
+            result.append(word);
+        }
+
+        return result;
+    }
+
+    /*
+     * Checks fingerprints against known values.  Returns the number of mismatches.
+     */
+    unsigned checkKnownFingerprints(unsigned long& numberChecked) {
+        unsigned numberMismatches = 0;
+
+        for (const KnownFingerprint& known : knownFingerprints) {
+            std::uint64_t result = fingerprint(known.text, known.shingleLength);
+
+            if (result != known.fingerprint) {
+                std::cout << "known fingerprint, \"" << known.text << "\", shingle length " << known.shingleLength
+                          << ": " << std::hex << result << ", expected " << known.fingerprint << std::dec
+                          << std::endl;
+                ++numberMismatches;
+            }
+
+            ++numberChecked;
+        }
+
+        return numberMismatches;
+    }
+
+    /*
+     * Checks that small edits to a document leave its fingerprint within a small Hamming distance and that unrelated
+     * documents are further apart.  Returns the number of mismatches.
+     */
+    unsigned checkNearDuplicates(unsigned long& numberChecked) {
+        unsigned numberMismatches = 0;
+
+        for (unsigned documentIndex=0 ; documentIndex<8 ; ++documentIndex) {
+            std::vector<std::string> words    = generateWords(documentIndex + 1, 3000);
+            std::uint64_t            original = fingerprint(join(words));
+
+            std::vector<std::string> replaced = words;
+            for (unsigned index=50 ; index<replaced.size() ; index+=100) {
+                replaced[index] = "replaced";
+            }
+
+            std::vector<std::string> inserted = words;
+            std::vector<std::string> sentence = generateWords(documentIndex + 1000, 20);
+            inserted.insert(inserted.begin() + 1500, sentence.begin(), sentence.end());
+
+            std::vector<std::string> deleted = words;
+            deleted.erase(deleted.begin() + 700, deleted.begin() + 730);
+
+            std::string reformatted = join(words);
+            std::replace(reformatted.begin(), reformatted.end(), ' ', '\n');
+
+            struct NearDuplicate {
+                const char*   name;
+                std::uint64_t fingerprint;
+            };
+
+            const NearDuplicate nearDuplicates[] = {
+                { "replaced words",    fingerprint(join(replaced)) },
+                { "inserted sentence", fingerprint(join(inserted)) },
+                { "deleted sentence",  fingerprint(join(deleted))  },
+                { "appended markup",   fingerprint(join(words) + " <p>Posted today</p>") }
+            };
+
+            for (const NearDuplicate& nearDuplicate : nearDuplicates) {
+                unsigned distance = SimHashSink::distance(original, nearDuplicate.fingerprint);
+
+                if (distance > maximumNearDistance) {
+                    std::cout << "near duplicates, document " << documentIndex << ", " << nearDuplicate.name
+                              << ": distance " << distance << std::endl;
+                    ++numberMismatches;
+                }
+
+                ++numberChecked;
+            }
+
+            if (fingerprint(reformatted) != original) {
+                std::cout << "near duplicates, document " << documentIndex << ": whitespace changed the fingerprint"
+                          << std::endl;
+                ++numberMismatches;
+            }
+
+            ++numberChecked;
+
+            std::uint64_t unrelated = fingerprint(join(generateWords(documentIndex + 500, 3000)));
+            unsigned      distance  = SimHashSink::distance(original, unrelated);
+
+            if (distance < minimumUnrelatedDistance) {
+                std::cout << "unrelated documents, document " << documentIndex << ": distance " << distance
+                          << std::endl;
+                ++numberMismatches;
+            }
+
+            ++numberChecked;
+        }
+
+        return numberMismatches;
+    }
+
+    /*
+     * Checks that data fed in pieces, split at pseudo-random points or one byte at a time, yields the same fingerprint
+     * as data fed in one call, and that a cleared sink can be reused.  Returns the number of mismatches.
+     */
+    unsigned checkSplitFeeding(unsigned long& numberChecked) {
+        static const unsigned maximumPieces[] = { 1, 2, 5, 33, 1000 };
+
+        unsigned numberMismatches = 0;
+
+        for (unsigned documentIndex=0 ; documentIndex<6 ; ++documentIndex) {
+            std::string data = generateDocument<std::string>(documentIndex + 300, 20000, documentIndex % 2 != 0);
+
+            for (unsigned shingleLength=1 ; shingleLength<=SimHashSink::maximumShingleLength ; ++shingleLength) {
+                std::uint64_t expected = fingerprint(data, shingleLength);
+                SimHashSink   sink(shingleLength);
+
+                for (unsigned maximumPiece : maximumPieces) {
+                    Random        random(documentIndex * 13 + maximumPiece);
+                    unsigned long index = 0;
+
+                    sink.clear();
+                    while (index < data.size()) {
+                        unsigned long pieceLength = std::min<unsigned long>(
+                            1 + random.next(maximumPiece),
+                            data.size() - index
+                        );
+
+                        sink.update(data.data() + index, pieceLength);
+                        index += pieceLength;
+                    }
+
+                    sink.finish();
+
+                    if (sink.result() != expected) {
+                        std::cout << "split feeding, document " << documentIndex << ", shingle length "
+                                  << shingleLength << ", maximum piece " << maximumPiece
+                                  << ": differs from one call" << std::endl;
+                        ++numberMismatches;
+                    }
+
+                    ++numberChecked;
+                }
+            }
+        }
+
+        return numberMismatches;
+    }
+}
+
+int main() {
+    unsigned long numberChecked    = 0;
+    unsigned      numberMismatches = 0;
+
+    numberMismatches += checkKnownFingerprints(numberChecked);
+    numberMismatches += checkNearDuplicates(numberChecked);
+    numberMismatches += checkSplitFeeding(numberChecked);
+
+    std::cout << numberChecked << " fingerprints checked, " << numberMismatches << " mismatches" << std::endl;
+    return numberMismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,214 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2022 - 2023 Inesonic, LLC.
+*
+* GNU Public License, Version 3:
+*   This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later
+*   version.
+*   
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*   
+*   You should have received a copy of the GNU General Public License along with this program.  If not, see
+*   <https://www.gnu.org/licenses/>.
+********************************************************************************************************************//**
+* \file
+*
+* This file checks \ref HtmlScrubber::Xxh64 against the published XXH64 reference values, feeding each input in one
+* piece, split at every offset, and one byte at a time.
+***********************************************************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "html_scrubber_xxh64.h"
+
+namespace {
+    typedef HtmlScrubber::Xxh64 Xxh64;
+
+    /*
+     * The seed, other than zero, used by the xxHash sanity checks.
+     */
+    const std::uint64_t prime32 = 2654435761ULL;
+
+    /*
+     * A reference value for a prefix of the xxHash sanity buffer.
+     */
+    struct SanityVector {
+        unsigned long length;
+        std::uint64_t seed;
+        std::uint64_t hash;
+    };
+
+    /*
+     * Reference values from the xxHash sanity checks run by xxhsum.
+     */
+    const SanityVector sanityVectors[] = {
+        {    0, 0,       0xEF46DB3751D8E999ULL },
+        {    0, prime32, 0xAC75FDA2929B17EFULL },
+        {    1, 0,       0xE934A84ADB052768ULL },
+        {    1, prime32, 0x5014607643A9B4C3ULL },
+        {    4, 0,       0x9136A0DCA57457EEULL },
+        {   14, 0,       0x8282DCC4994E35C8ULL },
+        {   14, prime32, 0xC3BD6BF63DEB6DF0ULL },
+        {  222, 0,       0xB641AE8CB691C174ULL },
+        {  222, prime32, 0x20CB8AB7AE10C14AULL },
+        { 2367, 0,       0xA82418DDEC0EA581ULL },
+        { 2367, prime32, 0xA36A93C18052673AULL }
+    };
+
+    /*
+     * A reference value for a string.
+     */
+    struct StringVector {
+        const char*   text;
+        std::uint64_t hash;
+    };
+
+    /*
+     * Reference values for short strings with a seed of zero.
+     */
+    const StringVector stringVectors[] = {
+        { "a",                                       0xD24EC4F1A98C6E5BULL },
+        { "abc",                                     0x44BC2CF5AD770999ULL },
+        { "Nobody inspects the spammish repetition", 0xFBCEA83C8A378BF1ULL }
+    };
+
+    /*
+     * Generates the xxHash sanity buffer.
+     */
+    std::string sanityBuffer(unsigned long length) {
+        const std::uint64_t prime64 = 11400714785074694797ULL;
+
+        std::string   result;
+        std::uint64_t generator = prime32;
+
+        for (unsigned long i=0 ; i<length ; ++i) {
+            result.push_back(static_cast<char>(generator >> 56));
+            generator *= prime64;
+        }
+
+        return result;
+    }
+
+    /*
+     * Reports a hash that does not match the reference value.  Returns 1 on mismatch and 0 otherwise.
+     */
+    unsigned compare(const std::string& description, std::uint64_t hash, std::uint64_t expected) {
+        unsigned result = 0;
+
+        if (hash != expected) {
+            std::cout << description << ": hash " << std::hex << hash << ", expected " << expected << std::dec
+                      << std::endl;
+            result = 1;
+        }
+
+        return result;
+    }
+
+    /*
+     * Checks one input against its reference value, hashed in one piece, split in two at every offset, and fed one
+     * byte at a time.  Returns the number of mismatches.
+     */
+    unsigned checkInput(
+            const std::string& description,
+            const std::string& input,
+            std::uint64_t      seed,
+            std::uint64_t      expected,
+            unsigned long&     numberChecked
+        ) {
+        unsigned numberMismatches = 0;
+
+        numberMismatches += compare(description, Xxh64::hash(input.data(), input.size(), seed), expected);
+        ++numberChecked;
+
+        Xxh64 hasher;
+        for (unsigned long split=0 ; split<=input.size() ; ++split) {
+            hasher.reset(seed);
+            hasher.addData(input.data(), split);
+            hasher.addData(input.data() + split, input.size() - split);
+
+            numberMismatches += compare(
+                description + ", split at " + std::to_string(split),
+                hasher.result(),
+                expected
+            );
+
+            ++numberChecked;
+        }
+
+        hasher.reset(seed);
+        for (char c : input) {
+            hasher.addData(&c, 1);
+        }
+
+        numberMismatches += compare(description + ", byte at a time", hasher.result(), expected);
+        ++numberChecked;
+
+        return numberMismatches;
+    }
+
+    /*
+     * Checks that the hash can be read part way through an input without changing the final result.  Returns the
+     * number of mismatches.
+     */
+    unsigned checkIntermediateResults(unsigned long& numberChecked) {
+        const SanityVector& vector = sanityVectors[sizeof(sanityVectors) / sizeof(sanityVectors[0]) - 1];
+        std::string         input  = sanityBuffer(vector.length);
+
+        unsigned numberMismatches = 0;
+        Xxh64    hasher(vector.seed);
+
+        for (unsigned long index=0 ; index<input.size() ; index+=7) {
+            unsigned long length = std::min<unsigned long>(7, input.size() - index);
+
+            numberMismatches += compare(
+                "intermediate result at " + std::to_string(index),
+                hasher.result(),
+                Xxh64::hash(input.data(), index, vector.seed)
+            );
+
+            hasher.addData(input.data() + index, length);
+            ++numberChecked;
+        }
+
+        numberMismatches += compare("result after intermediate results", hasher.result(), vector.hash);
+        ++numberChecked;
+
+        return numberMismatches;
+    }
+}
+
+int main() {
+    unsigned long numberChecked    = 0;
+    unsigned      numberMismatches = 0;
+
+    for (const SanityVector& vector : sanityVectors) {
+        numberMismatches += checkInput(
+            "sanity buffer, length " + std::to_string(vector.length) + ", seed " + std::to_string(vector.seed),
+            sanityBuffer(vector.length),
+            vector.seed,
+            vector.hash,
+            numberChecked
+        );
+    }
+
+    for (const StringVector& vector : stringVectors) {
+        numberMismatches += checkInput(
+            std::string("\"") + vector.text + "\"",
+            vector.text,
+            0,
+            vector.hash,
+            numberChecked
+        );
+    }
+
+    numberMismatches += checkIntermediateResults(numberChecked);
+
+    std::cout << numberChecked << " hashes checked, " << numberMismatches << " mismatches" << std::endl;
+    return numberMismatches == 0 ? 0 : 1;
+}